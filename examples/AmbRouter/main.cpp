@@ -13,9 +13,9 @@
 #include <AppComponents/Common/Matcher/GraphBuilder.h>
 #include <AppComponents/Common/Matcher/Router.h>
 #include <AppComponents/Common/Matcher/SamplingPointFinder.h>
-#include <AppComponents/Common/Reader/CsvTrackReader.h>
-#include <AppComponents/Common/Reader/GeoJsonMapReader.h>
 #include <AppComponents/Common/Reader/JsonTrackReader.h>
+#include <AppComponents/Common/Reader/MappedCsvTrackReader.h>
+#include <AppComponents/Common/Reader/MappedGeoJsonMapReader.h>
 #include <AppComponents/Common/Reader/OsmMapReader.h>
 #include <AppComponents/Common/Writer/GeoJsonMapWriter.h>
 #include <AppComponents/Common/Writer/GeoJsonTrackWriter.h>
@@ -100,6 +100,7 @@ struct UserOptions : public cliapp::UserOptionsBase
     std::string dbPass{"docker"};
     unsigned short dbPort{5432};
     bool noSplitStreets{false};
+    bool packedMap{false};
 };
 
 int app(UserOptions options)
@@ -130,6 +131,7 @@ int app(UserOptions options)
     double const maxVelocityDifference = 10.0;
     double const maxSamplingPointSkippingDistance = 3000.0;
     double const maxCandidateBacktrackingDistance = 1000.0;
+    size_t const maxCandidatesPerSamplingPoint = 0;
 
     auto postgresConnection = Core::Common::Postgres::Connection{
         Core::Common::Postgres::Connection::Strategy::globalUnlocked, options.dbHost, options.dbPort, options.dbName, options.dbUser, options.dbPass};
@@ -143,16 +145,19 @@ int app(UserOptions options)
 
     APP_LOG_MS(info) << "Reader start.";
 
-    auto trackIn = std::ifstream{options.trackIn};
     {
         auto extension = std::filesystem::path(options.trackIn).extension();
         if (extension == ".csv" || extension == ".txt")
         {
-            AppComponents::Common::Reader::CsvTrackReader{trackIn}(context.track.timeList, context.track.pointList, context.track.headingList, context.track.velocityList);
+            AppComponents::Common::Reader::MappedCsvTrackReader{options.trackIn}(
+                context.track.timeList, context.track.pointList, context.track.headingList, context.track.velocityList);
             APP_LOG(info) << "len(context.track.timeList) = " << context.track.timeList.size();
         }
         else if (extension == ".json")
+        {
+            auto trackIn = std::ifstream{options.trackIn};
             AppComponents::Common::Reader::JsonTrackReader{trackIn}(context.track.timeList, context.track.pointList, context.track.headingList, context.track.velocityList);
+        }
         else
         {
             APP_LOG(fatal) << "Track input file extension unknown: " << extension;
@@ -161,7 +166,6 @@ int app(UserOptions options)
     }
 
     APP_LOG_MS(info) << "MapReader start.";
-    auto mapIn = std::ifstream{};
     if (options.mapIn.empty())
     {
         using Types::Street::HighwayType;
@@ -188,10 +192,9 @@ int app(UserOptions options)
     }
     else
     {
-        mapIn = std::ifstream{options.mapIn};
         auto extension = std::filesystem::path(options.mapIn).extension();
         if (extension == ".geojson")
-            AppComponents::Common::Reader::GeoJsonMapReader{mapIn}(
+            AppComponents::Common::Reader::MappedGeoJsonMapReader{options.mapIn}(
                 context.street.segmentList, context.street.nodePairList, context.street.travelDirectionList, context.street.highwayList);
         else
         {
@@ -201,6 +204,11 @@ int app(UserOptions options)
     }
     APP_LOG_MS(info) << "MapReader finished.";
 
+    // The candidate search and the map writer read the street geometries from a compact copy if requested.
+    auto segmentGeometryList = std::unique_ptr<Types::Street::SegmentGeometryList>{};
+    if (options.packedMap)
+        segmentGeometryList = std::make_unique<Types::Street::SegmentGeometryList>(Types::Street::toSegmentGeometryList(context.street.segmentList));
+
     APP_LOG_MS(info) << "Reader finished.";
 
     // TODO: Extend Reader Interface with registrable thread pool functionality to maintain multithreading while reading
@@ -221,7 +229,9 @@ int app(UserOptions options)
         Matcher::Routing::RouteClusterPreference::shortest,
         context.track.timeList,
         context.track.velocityList,
-        context.street.segmentList});
+        context.street.segmentList,
+        nullptr,
+        maxCandidatesPerSamplingPoint});
     pipeline.add(Matcher::GraphBuilder{context.street.nodePairList, context.street.travelDirectionList});
     pipeline.add(Matcher::SamplingPointFinder{
         Matcher::SamplingPointFinder::SelectionStrategy::all,
@@ -230,7 +240,8 @@ int app(UserOptions options)
         context.track.pointList,
         context.track.headingList,
         context.street.segmentList,
-        context.street.travelDirectionList});
+        context.street.travelDirectionList,
+        segmentGeometryList.get()});
     // Note: ensure shall not be empty so the Pipeline optimizer does not clear the whole piepline
     ensure.emplace_back("Router");
 
@@ -257,7 +268,7 @@ int app(UserOptions options)
     if (!options.mapOut.empty())
     {
         mapOut = std::make_unique<std::ofstream>(options.mapOut);
-        Writer::GeoJsonMapWriter{*mapOut}(context.street.segmentList, context.street.nodePairList, context.street.travelDirectionList, context.street.highwayList);
+        Writer::GeoJsonMapWriter{*mapOut, segmentGeometryList.get()}(context.street.segmentList, context.street.nodePairList, context.street.travelDirectionList, context.street.highwayList);
     }
 
     auto routeCsvOut = std::unique_ptr<std::ofstream>{};
@@ -320,7 +331,8 @@ int main(int argc, char * argv[])
         | lyra::opt(options.pipelineOut, "file")["--pipeline"]("pipeline graph output (dot)").optional() | lyra::opt(options.dbHost, "db host")["--host"]("db host name").optional()
         | lyra::opt(options.dbPort, "db port")["--port"]("db host port").optional() | lyra::opt(options.dbName, "db name")["--db"]("database").optional()
         | lyra::opt(options.dbUser, "db user")["--dbuser"]("db user").optional() | lyra::opt(options.dbPass, "db password")["--dbpasswd"]("db password").optional()
-        | lyra::opt(options.noSplitStreets)["--no-split-streets"]("do not split streets on overlapping points").optional();
+        | lyra::opt(options.noSplitStreets)["--no-split-streets"]("do not split streets on overlapping points").optional()
+        | lyra::opt(options.packedMap)["--packed-map"]("search candidates on and write the map from E7 fixed-point street geometries").optional();
 
     return cliapp::main(argc, argv, cli, options, "AmbRouter", "v" + std::string{OSMATCHER_VERSION_SHORT}, "Ambrosys Router application.", app);
 }
@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Matcher/BatchRouter.h>
+#include <AppComponents/Common/Matcher/Router.h>
+
+#include <Generic/Parallel/Parallel.h>
+
+#include <amblog/global.h>
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace AppComponents::Common::Matcher {
+
+BatchRouter::BatchRouter(
+    double const maxVelocityDifference,
+    bool const allowSelfIntersection,
+    double const maxAngularDeviation,
+    double const accountTurningCircleLength,
+    double const maxSamplingPointSkippingDistance,
+    Routing::SamplingPointSkipStrategy const samplingPointSkipStrategy,
+    double const maxCandidateBacktrackingDistance,
+    double const maxClusteredRoutesLengthDifference,
+    Routing::RouteClusterPreference const routeClusterPreference,
+    Types::Street::SegmentList const & segmentList,
+    size_t const threadCount,
+    std::shared_ptr<Routing::PathCache> pathCache,
+    size_t const maxCandidatesPerSamplingPoint)
+  : maxVelocityDifference_(maxVelocityDifference), allowSelfIntersection_(allowSelfIntersection), maxAngularDeviation_(maxAngularDeviation),
+    accountTurningCircleLength_(accountTurningCircleLength), maxSamplingPointSkippingDistance_(maxSamplingPointSkippingDistance),
+    samplingPointSkipStrategy_(samplingPointSkipStrategy), maxCandidateBacktrackingDistance_(maxCandidateBacktrackingDistance),
+    maxClusteredRoutesLengthDifference_(maxClusteredRoutesLengthDifference), routeClusterPreference_(routeClusterPreference),
+    segmentList_(segmentList), threadCount_(threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())),
+    pathCache_(std::move(pathCache)), maxCandidatesPerSamplingPoint_(maxCandidatesPerSamplingPoint)
+{
+}
+
+std::vector<BatchRouter::Result> BatchRouter::operator()(
+    std::vector<Track> const & tracks,
+    Types::Graph::Graph const & graph,
+    Types::Graph::GraphEdgeMap const & graphEdgeMap,
+    Types::Graph::StreetIndexMap const & streetIndexMap) const
+{
+    APP_LOG_LOCATION("BatchRouter");
+
+    auto const pathCache = pathCache_ ? pathCache_ : std::make_shared<Routing::PathCache>();
+    auto const pathCacheHits = pathCache->hits();
+    auto const pathCacheMisses = pathCache->misses();
+
+    auto results = std::vector<Result>(tracks.size());
+    Generic::Parallel::forEachBatch(
+        tracks.size(),
+        1,
+        threadCount_,
+        [&](size_t const trackIndex, size_t)
+        {
+            auto const & track = tracks[trackIndex];
+            auto & result = results[trackIndex];
+            auto router = Router{
+                maxVelocityDifference_,
+                allowSelfIntersection_,
+                maxAngularDeviation_,
+                accountTurningCircleLength_,
+                maxSamplingPointSkippingDistance_,
+                samplingPointSkipStrategy_,
+                maxCandidateBacktrackingDistance_,
+                maxClusteredRoutesLengthDifference_,
+                routeClusterPreference_,
+                track.timeList,
+                track.velocityList,
+                segmentList_,
+                pathCache,
+                maxCandidatesPerSamplingPoint_};
+            router(track.samplingPointList, graph, graphEdgeMap, streetIndexMap, result.routeList, result.routingStatistic);
+        });
+
+    APP_LOG(debug) << "matched " << tracks.size() << " tracks, path cache: " << pathCache->hits() - pathCacheHits << " hits, " << pathCache->misses() - pathCacheMisses
+                   << " misses";
+
+    return results;
+}
+
+}  // namespace AppComponents::Common::Matcher
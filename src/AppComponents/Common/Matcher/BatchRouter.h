@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <AppComponents/Common/Matcher/Routing/PathCache.h>
+#include <AppComponents/Common/Matcher/Routing/Types.h>
+#include <AppComponents/Common/Types/Graph/EdgeMap.h>
+#include <AppComponents/Common/Types/Graph/Graph.h>
+#include <AppComponents/Common/Types/Routing/Edge.h>
+#include <AppComponents/Common/Types/Routing/SamplingPoint.h>
+#include <AppComponents/Common/Types/Routing/Statistic.h>
+#include <AppComponents/Common/Types/Street/Segment.h>
+#include <AppComponents/Common/Types/Track/Time.h>
+#include <AppComponents/Common/Types/Track/Velocity.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace AppComponents::Common::Matcher {
+
+/**
+ * Matches several tracks on the same street map with the `Router`, on several threads.
+ *
+ * All tracks share one `PathCache`, so paths found for one track are reused by the others.
+ */
+class BatchRouter
+{
+public:
+    struct Track
+    {
+        Types::Routing::SamplingPointList const & samplingPointList;
+        Types::Track::TimeList const & timeList;
+        Types::Track::VelocityList const & velocityList;
+    };
+
+    struct Result
+    {
+        Types::Routing::RouteList routeList;
+        Types::Routing::RoutingStatistic routingStatistic;
+    };
+
+    /// See `Router` for the configuration.
+    /// @param threadCount Number of threads matching tracks, 0 to use one per hardware thread.
+    /// @param pathCache Shared by all tracks (and further batches if given), else a new cache is used per batch.
+    BatchRouter(
+        double maxVelocityDifference,
+        bool allowSelfIntersection,
+        double maxAngularDeviation,
+        double accountTurningCircleLength,
+        double maxSamplingPointSkippingDistance,
+        Routing::SamplingPointSkipStrategy samplingPointSkipStrategy,
+        double maxCandidateBacktrackingDistance,
+        double maxClusteredRoutesLengthDifference,
+        Routing::RouteClusterPreference routeClusterPreference,
+        Types::Street::SegmentList const & segmentList,
+        size_t threadCount = 0,
+        std::shared_ptr<Routing::PathCache> pathCache = nullptr,
+        size_t maxCandidatesPerSamplingPoint = 0);
+
+    /**
+     * @return The result of each track, in the order of \p tracks.
+     */
+    std::vector<Result> operator()(
+        std::vector<Track> const & tracks,
+        Types::Graph::Graph const & graph,
+        Types::Graph::GraphEdgeMap const & graphEdgeMap,
+        Types::Graph::StreetIndexMap const & streetIndexMap) const;
+
+private:
+    double const maxVelocityDifference_;
+    bool const allowSelfIntersection_;
+    double const maxAngularDeviation_;
+    double const accountTurningCircleLength_;
+    double const maxSamplingPointSkippingDistance_;
+    Routing::SamplingPointSkipStrategy const samplingPointSkipStrategy_;
+    double const maxCandidateBacktrackingDistance_;
+    double const maxClusteredRoutesLengthDifference_;
+    Routing::RouteClusterPreference const routeClusterPreference_;
+    Types::Street::SegmentList const & segmentList_;
+    size_t const threadCount_;
+    std::shared_ptr<Routing::PathCache> const pathCache_;
+    size_t const maxCandidatesPerSamplingPoint_;
+};
+
+}  // namespace AppComponents::Common::Matcher
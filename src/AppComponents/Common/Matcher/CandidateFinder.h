@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-FileContributor: Fabian Sandoval Saldias <fabianvss@gmail.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <AppComponents/Common/Types/Routing/SamplingPoint.h>
+#include <AppComponents/Common/Types/Street/Segment.h>
+#include <AppComponents/Common/Types/Street/TravelDirection.h>
+#include <AppComponents/Common/Types/Track/Heading.h>
+#include <AppComponents/Common/Types/Track/Point.h>
+
+#include <Core/Common/Geometry/Types.h>
+
+#include <boost/geometry/index/rtree.hpp>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace AppComponents::Common::Matcher {
+
+/**
+ * Finds the street candidates of single track points.
+ *
+ * The spatial index of the streets is built once, so track points can be looked up one at a time.
+ */
+class CandidateFinder
+{
+public:
+    using StreetIndexGeoindexGeometry = boost::geometry::model::box<Core::Common::Geometry::Point>;
+    using StreetIndexGeoindexValue = std::pair<StreetIndexGeoindexGeometry, std::pair<size_t, size_t>>;
+    using StreetIndexGeoindexAlgorithm = boost::geometry::index::quadratic<16>;
+    using StreetIndexGeoindex = boost::geometry::index::rtree<StreetIndexGeoindexValue, StreetIndexGeoindexAlgorithm>;
+
+    /// @param segmentGeometryList Read instead of the geometries of \p segmentList if given.
+    CandidateFinder(
+        double searchRadius,
+        double maxHeadingDifference,
+        Types::Street::SegmentList const & segmentList,
+        Types::Street::TravelDirectionList const & travelDirectionList,
+        Types::Street::SegmentGeometryList const * segmentGeometryList = nullptr);
+
+    /**
+     * @param heading Heading of the track point, if known.
+     * @return The candidates ordered from best to worst.
+     */
+    std::vector<Types::Routing::SamplingPointCandidate> operator()(Types::Track::Point const & point, std::optional<Types::Track::Heading> heading) const;
+
+private:
+    double const searchRadius_;
+    double const maxHeadingDifference_;
+    Types::Street::SegmentList const & segmentList_;
+    Types::Street::TravelDirectionList const & travelDirectionList_;
+    Types::Street::SegmentGeometryList const * const segmentGeometryList_;
+    StreetIndexGeoindex geoindex_;
+};
+
+}  // namespace AppComponents::Common::Matcher
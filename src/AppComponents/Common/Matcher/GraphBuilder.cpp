@@ -6,10 +6,11 @@
 
 #include <AppComponents/Common/Matcher/GraphBuilder.h>
 
+#include <Generic/Map/FlatHashMap.h>
+
 #include <amblog/global.h>
 
 #include <cassert>
-#include <unordered_map>
 
 namespace AppComponents::Common::Matcher {
 
@@ -30,8 +31,12 @@ bool GraphBuilder::operator()(
 {
     assert(nodePairList_.size() == travelDirectionList_.size());
 
+    streetIndexMap.reserve(nodePairList_.size());
+    graphEdgeMap.reserve(2 * nodePairList_.size());
+
     // TODO: std::optional only because Node is not default-constructible.
-    auto streetNodeMap = std::unordered_map<size_t, std::optional<Core::Graph::Node>>{};
+    auto streetNodeMap = Generic::FlatHashMap<size_t, std::optional<Core::Graph::Node>>{};
+    streetNodeMap.reserve(nodePairList_.size());
 
     auto getOrAddNode = [&](size_t const id) -> std::optional<Core::Graph::Node>
     {
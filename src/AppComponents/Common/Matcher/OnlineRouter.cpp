@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Matcher/OnlineRouter.h>
+#include <AppComponents/Common/Matcher/Routing/Helper.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <unordered_map>
+
+namespace AppComponents::Common::Matcher {
+
+namespace {
+
+    template <typename List>
+    void eraseFront(List & list, size_t const count)
+    {
+        list.erase(list.begin(), list.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+
+    size_t bestStateIndex(Routing::ViterbiLattice::Layer const & layer)
+    {
+        assert(!layer.empty());
+        return static_cast<size_t>(
+            std::min_element(layer.begin(), layer.end(), [](auto const & a, auto const & b) { return a.cost < b.cost; }) - layer.begin());
+    }
+
+}  // namespace
+
+OnlineRouter::OnlineRouter(
+    Configuration const configuration,
+    Types::Street::SegmentList const & segmentList,
+    Types::Street::TravelDirectionList const & travelDirectionList,
+    Types::Graph::Graph const & graph,
+    Types::Graph::GraphEdgeMap const & graphEdgeMap,
+    Types::Graph::StreetIndexMap const & streetIndexMap,
+    std::shared_ptr<Routing::PathCache> pathCache)
+  : configuration_(configuration), candidateFinder_(configuration.searchRadius, configuration.maxHeadingDifference, segmentList, travelDirectionList),
+    streetLengthRouting_(
+        {configuration.maxVelocityDifference, configuration.allowSelfIntersection, configuration.maxAngularDeviation, configuration.accountTurningCircleLength},
+        samplingPointList_,
+        graph,
+        graphEdgeMap,
+        streetIndexMap,
+        timeList_,
+        velocityList_,
+        segmentList,
+        std::move(pathCache),
+        Types::Routing::heapArena()),
+    viterbiLattice_(
+        streetLengthRouting_.router(),
+        {configuration.measurementNoise, configuration.headingNoise, configuration.transitionScale, configuration.maxCandidatesPerSamplingPoint},
+        samplingPointList_)
+{
+}
+
+OnlineRouter::Update OnlineRouter::operator()(TrackPoint const & trackPoint)
+{
+    auto update = Update{};
+
+    // Indices into the kept lists, the routes get the indices counting all points.
+    auto const trackIndex = pointList_.size();
+    pointList_.push_back(trackPoint.point);
+    timeList_.push_back(trackPoint.time);
+    velocityList_.push_back(trackPoint.velocity);
+
+    auto candidates = candidateFinder_(trackPoint.point, trackPoint.heading);
+    if (!candidates.empty())
+    {
+        samplingPointList_.push_back({trackIndex, std::move(candidates)});
+        auto const samplingPointIndex = samplingPointList_.size() - 1;
+        samplingPointDistanceList_.push_back(
+            samplingPointIndex == 0 ? 0.0
+                                    : samplingPointDistanceList_.back() + Routing::calcApproximateDistanceBetweenSamplingPoints(samplingPointIndex - 1, samplingPointIndex, samplingPointList_));
+
+        auto layer = viterbiLattice_.makeLayer(samplingPointIndex);
+        if (!layers_.empty() && !viterbiLattice_.connect(layers_.back(), layer, routingStatistic_))
+        {
+            // The track is interrupted here, so the best path of the window is final.
+            commit(layers_.size() - 1, bestStateIndex(layers_.back()), update.finalRoutes);
+            layers_.clear();
+        }
+        if (layers_.empty())
+            Routing::ViterbiLattice::restart(layer);
+        else
+            for (auto const & state : layer)
+            {
+                // The routes were just created for this layer, so they are only shifted once.
+                state.route->source.samplingPoint.index += samplingPointOffset_;
+                state.route->target.samplingPoint.index += samplingPointOffset_;
+            }
+        layers_.push_back(std::move(layer));
+        routingStatistic_ = {};
+
+        if (auto const convergence = findConvergence())
+            commit(convergence->first, convergence->second, update.finalRoutes);
+
+        // Keep the window bounded by finalising the routes too far back on the currently best path.
+        auto const distanceToNewest = [&](size_t const layerIndex)
+        { return samplingPointDistanceList_.back() - samplingPointDistanceList_[layers_[layerIndex].front().selection.index]; };
+        if (layers_.size() > 1 && distanceToNewest(1) > configuration_.maxWindowDistance)
+        {
+            size_t layerIndex = 1;
+            while (layerIndex + 1 < layers_.size() && distanceToNewest(layerIndex + 1) > configuration_.maxWindowDistance)
+                ++layerIndex;
+            commit(layerIndex, bestPath()[layerIndex], update.finalRoutes);
+        }
+    }
+    trim();
+
+    if (!layers_.empty())
+        update.provisionalRoutes = trace(layers_.size() - 1, bestStateIndex(layers_.back()));
+
+    return update;
+}
+
+Types::Routing::RouteList OnlineRouter::finish()
+{
+    auto finalRoutes = Types::Routing::RouteList{};
+    if (!layers_.empty())
+        commit(layers_.size() - 1, bestStateIndex(layers_.back()), finalRoutes);
+    layers_.clear();
+    trim();
+    return finalRoutes;
+}
+
+void OnlineRouter::commit(size_t const layerIndex, size_t const stateIndex, Types::Routing::RouteList & finalRoutes)
+{
+    auto routes = trace(layerIndex, stateIndex);
+    finalRoutes.insert(finalRoutes.end(), routes.begin(), routes.end());
+
+    // The committed state starts the window, only the states following it are kept.
+    auto committedState = std::move(layers_[layerIndex][stateIndex]);
+    committedState.previous = std::nullopt;
+    committedState.route = nullptr;
+    layers_[layerIndex] = {std::move(committedState)};
+    layers_.erase(layers_.begin(), layers_.begin() + static_cast<std::ptrdiff_t>(layerIndex));
+
+    auto keptIndices = std::unordered_map<size_t, size_t>{{stateIndex, 0}};
+    for (size_t index = 1; index < layers_.size(); ++index)
+    {
+        auto & layer = layers_[index];
+        auto newKeptIndices = std::unordered_map<size_t, size_t>{};
+        auto keptLayer = Layer{};
+        for (size_t stateIndexInLayer = 0; stateIndexInLayer < layer.size(); ++stateIndexInLayer)
+        {
+            auto & state = layer[stateIndexInLayer];
+            if (auto it = keptIndices.find(*state.previous); it != keptIndices.end())
+            {
+                state.previous = it->second;
+                newKeptIndices.emplace(stateIndexInLayer, keptLayer.size());
+                keptLayer.push_back(std::move(state));
+            }
+        }
+        layer = std::move(keptLayer);
+        keptIndices = std::move(newKeptIndices);
+    }
+}
+
+Types::Routing::RouteList OnlineRouter::trace(size_t layerIndex, size_t stateIndex) const
+{
+    auto routes = Types::Routing::RouteList{};
+    routes.reserve(layerIndex);
+    for (; layerIndex > 0; --layerIndex)
+    {
+        auto const & state = layers_[layerIndex][stateIndex];
+        routes.push_back(state.route);
+        stateIndex = *state.previous;
+    }
+    std::reverse(routes.begin(), routes.end());
+    return routes;
+}
+
+std::vector<size_t> OnlineRouter::bestPath() const
+{
+    auto path = std::vector<size_t>(layers_.size());
+    path.back() = bestStateIndex(layers_.back());
+    for (size_t layerIndex = layers_.size() - 1; layerIndex > 0; --layerIndex)
+        path[layerIndex - 1] = *layers_[layerIndex][path[layerIndex]].previous;
+    return path;
+}
+
+std::optional<std::pair<size_t, size_t>> OnlineRouter::findConvergence() const
+{
+    auto stateIndices = std::vector<size_t>(layers_.back().size());
+    for (size_t stateIndex = 0; stateIndex < stateIndices.size(); ++stateIndex)
+        stateIndices[stateIndex] = stateIndex;
+
+    for (size_t layerIndex = layers_.size() - 1; layerIndex > 0; --layerIndex)
+    {
+        if (stateIndices.size() == 1)
+            return std::make_pair(layerIndex, stateIndices.front());
+
+        auto previousStateIndices = std::vector<size_t>{};
+        for (auto const stateIndex : stateIndices)
+            previousStateIndices.push_back(*layers_[layerIndex][stateIndex].previous);
+        std::sort(previousStateIndices.begin(), previousStateIndices.end());
+        previousStateIndices.erase(std::unique(previousStateIndices.begin(), previousStateIndices.end()), previousStateIndices.end());
+        stateIndices = std::move(previousStateIndices);
+    }
+    // Converging in the first layer finalises no route.
+    return std::nullopt;
+}
+
+void OnlineRouter::trim()
+{
+    // The window starts at the sampling point of its first layer, the points before are no longer routed.
+    auto const samplingPointCount = layers_.empty() ? samplingPointList_.size() : layers_.front().front().selection.index;
+    auto const trackPointCount = samplingPointCount < samplingPointList_.size() ? samplingPointList_[samplingPointCount].trackIndex : pointList_.size();
+    if (samplingPointCount == 0 && trackPointCount == 0)
+        return;
+
+    eraseFront(samplingPointList_, samplingPointCount);
+    eraseFront(samplingPointDistanceList_, samplingPointCount);
+    eraseFront(pointList_, trackPointCount);
+    eraseFront(timeList_, trackPointCount);
+    eraseFront(velocityList_, trackPointCount);
+    for (auto & samplingPoint : samplingPointList_)
+        samplingPoint.trackIndex -= trackPointCount;
+    for (auto & layer : layers_)
+        for (auto & state : layer)
+            state.selection.index -= samplingPointCount;
+
+    samplingPointOffset_ += samplingPointCount;
+    trackOffset_ += trackPointCount;
+}
+
+}  // namespace AppComponents::Common::Matcher
@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <AppComponents/Common/Matcher/CandidateFinder.h>
+#include <AppComponents/Common/Matcher/Routing/PathCache.h>
+#include <AppComponents/Common/Matcher/Routing/StreetLengthRouting.h>
+#include <AppComponents/Common/Matcher/Routing/ViterbiLattice.h>
+#include <AppComponents/Common/Types/Graph/EdgeMap.h>
+#include <AppComponents/Common/Types/Graph/Graph.h>
+#include <AppComponents/Common/Types/Routing/Edge.h>
+#include <AppComponents/Common/Types/Routing/SamplingPoint.h>
+#include <AppComponents/Common/Types/Routing/Statistic.h>
+#include <AppComponents/Common/Types/Street/Segment.h>
+#include <AppComponents/Common/Types/Street/TravelDirection.h>
+#include <AppComponents/Common/Types/Track/Heading.h>
+#include <AppComponents/Common/Types/Track/Point.h>
+#include <AppComponents/Common/Types/Track/Time.h>
+#include <AppComponents/Common/Types/Track/Velocity.h>
+
+#include <deque>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace AppComponents::Common::Matcher {
+
+/**
+ * Matches a track while its points arrive, for live feeds.
+ *
+ * Unlike the filters, which process a whole track at once, each appended track point only extends the candidates and routes of a sliding window,
+ * using the same hidden Markov model as the `ViterbiRouter`.
+ * Routes are final as soon as they can no longer change (when the best paths to all states of the newest sampling point share them),
+ * or when they lie further back than `maxWindowDistance`, which bounds the work per track point.
+ * The routes of the remaining window are reported as provisional routes.
+ *
+ * Only the track points and sampling points from the window start on are kept, so the memory is bounded by the window, not by the track.
+ * The sampling point indices of the routes count all sampling points found so far, the track indices count all appended track points.
+ */
+class OnlineRouter
+{
+public:
+    struct Configuration
+    {
+        double searchRadius;  ///< See `SamplingPointFinder`.
+        double maxHeadingDifference;  ///< See `SamplingPointFinder`.
+        double maxVelocityDifference;  ///< See `Router`.
+        bool allowSelfIntersection;  ///< See `Router`.
+        double maxAngularDeviation;  ///< See `Router`.
+        double accountTurningCircleLength;  ///< See `Router`.
+        double measurementNoise;  ///< See `ViterbiRouter`.
+        double headingNoise;  ///< See `ViterbiRouter`.
+        double transitionScale;  ///< See `ViterbiRouter`.
+        size_t maxCandidatesPerSamplingPoint;  ///< See `ViterbiRouter`.
+        double maxWindowDistance;  ///< Routes further back than this distance (measured along the sampling points) are finalised on the currently best path.
+    };
+
+    struct TrackPoint
+    {
+        Types::Track::Point point;
+        std::optional<Types::Track::Heading> heading;
+        Types::Track::Time time;
+        Types::Track::Velocity velocity;
+    };
+
+    struct Update
+    {
+        Types::Routing::RouteList finalRoutes;  ///< Routes following the previously finalised ones, they will not change anymore.
+        Types::Routing::RouteList provisionalRoutes;  ///< Currently best routes following `finalRoutes`, replacing the previously reported ones.
+    };
+
+    OnlineRouter(
+        Configuration const configuration,
+        Types::Street::SegmentList const & segmentList,
+        Types::Street::TravelDirectionList const & travelDirectionList,
+        Types::Graph::Graph const & graph,
+        Types::Graph::GraphEdgeMap const & graphEdgeMap,
+        Types::Graph::StreetIndexMap const & streetIndexMap,
+        std::shared_ptr<Routing::PathCache> pathCache = nullptr);
+
+    // The routers reference the track data members.
+    OnlineRouter(OnlineRouter const &) = delete;
+    OnlineRouter & operator=(OnlineRouter const &) = delete;
+
+    /**
+     * Appends a track point.
+     */
+    Update operator()(TrackPoint const & trackPoint);
+
+    /**
+     * Finalises the routes of the remaining window, f.ex. at the end of the track.
+     */
+    Types::Routing::RouteList finish();
+
+    /// The sampling points of the window, the first one has the index `samplingPointOffset()`. Their track indices refer to `timeList()`.
+    Types::Routing::SamplingPointList const & samplingPointList() const { return samplingPointList_; }
+    size_t samplingPointOffset() const { return samplingPointOffset_; }
+
+    /// The times of the track points of the window, the first one was appended as track point `trackOffset()`.
+    Types::Track::TimeList const & timeList() const { return timeList_; }
+    size_t trackOffset() const { return trackOffset_; }
+
+private:
+    using Layer = Routing::ViterbiLattice::Layer;
+
+    /**
+     * Finalises the routes of the best path to the given state and keeps only the lattice part which can still follow it.
+     */
+    void commit(size_t layerIndex, size_t stateIndex, Types::Routing::RouteList & finalRoutes);
+
+    /// @return The routes of the best path from the window start to the given state.
+    Types::Routing::RouteList trace(size_t layerIndex, size_t stateIndex) const;
+
+    /// @return The state indices of the best path to the best state of the newest layer, indexed by layer.
+    std::vector<size_t> bestPath() const;
+
+    /// @return The newest layer and state shared by the best paths to all states of the newest layer, if any.
+    std::optional<std::pair<size_t, size_t>> findConvergence() const;
+
+    /**
+     * Drops the track points and sampling points before the window start and rebases the indices of the window to the kept ones.
+     */
+    void trim();
+
+    Configuration const configuration_;
+    Types::Track::PointList pointList_;
+    Types::Track::TimeList timeList_;
+    Types::Track::VelocityList velocityList_;
+    Types::Routing::SamplingPointList samplingPointList_;
+    Types::Routing::SamplingPointDistanceList samplingPointDistanceList_;
+    size_t trackOffset_{0};  ///< Number of track points dropped from the track lists.
+    size_t samplingPointOffset_{0};  ///< Number of sampling points dropped from the sampling point lists.
+    CandidateFinder const candidateFinder_;
+    Routing::StreetLengthRouting const streetLengthRouting_;
+    Routing::ViterbiLattice const viterbiLattice_;
+    std::deque<Layer> layers_;  ///< The window, the states of its first layer are either final or start a piece.
+    Types::Routing::RoutingStatistic routingStatistic_;  ///< Only needed by the lattice, it is cleared after each track point so it does not grow with the track.
+};
+
+}  // namespace AppComponents::Common::Matcher
@@ -8,13 +8,15 @@
 
 #include <AppComponents/Common/Matcher/Router.h>
 #include <AppComponents/Common/Matcher/Routing/BacktrackRouter.h>
-#include <AppComponents/Common/Matcher/Routing/DirectedCandidateRouter.h>
 #include <AppComponents/Common/Matcher/Routing/Helper.h>
 #include <AppComponents/Common/Matcher/Routing/PiecewiseRouter.h>
 #include <AppComponents/Common/Matcher/Routing/SamplingPointRouter.h>
 #include <AppComponents/Common/Matcher/Routing/SkipRouter.h>
+#include <AppComponents/Common/Matcher/Routing/StreetLengthRouting.h>
 
-#include <Core/Graph/Routing/Dijkstra.h>
+#include <amblog/global.h>
+
+#include <utility>
 
 namespace AppComponents::Common::Matcher {
 
@@ -30,12 +32,14 @@ Router::Router(
     Routing::RouteClusterPreference const routeClusterPreference,
     Types::Track::TimeList const & timeList,
     Types::Track::VelocityList const & velocityList,
-    Types::Street::SegmentList const & segmentList)
+    Types::Street::SegmentList const & segmentList,
+    std::shared_ptr<Routing::PathCache> pathCache,
+    size_t const maxCandidatesPerSamplingPoint)
   : Filter("Router"), maxVelocityDifference_(maxVelocityDifference), allowSelfIntersection_(allowSelfIntersection), maxAngularDeviation_(maxAngularDeviation),
     accountTurningCircleLength_(accountTurningCircleLength), maxSamplingPointSkippingDistance_(maxSamplingPointSkippingDistance),
     samplingPointSkipStrategy_(samplingPointSkipStrategy), maxCandidateBacktrackingDistance_(maxCandidateBacktrackingDistance),
     maxClusteredRoutesLengthDifference_(maxClusteredRoutesLengthDifference), routeClusterPreference_(routeClusterPreference),
-    timeList_(timeList), velocityList_(velocityList), segmentList_(segmentList)
+    timeList_(timeList), velocityList_(velocityList), segmentList_(segmentList), pathCache_(std::move(pathCache)), maxCandidatesPerSamplingPoint_(maxCandidatesPerSamplingPoint)
 {
     setRequirements({"SamplingPointList", "Graph", "GraphEdgeMap", "StreetIndexMap"});
     setOptionals({});
@@ -50,28 +54,34 @@ bool Router::operator()(
     Types::Routing::RouteList & routeList,
     Types::Routing::RoutingStatistic & routingStatistic)
 {
-    auto algorithm = Core::Graph::Routing::Dijkstra{graph};
-    auto costFunction = [&](Core::Graph::Edge edge) { return Routing::geoDistance(segmentList_.at(graphEdgeMap.at(edge).streetIndex).geometry); };
-    algorithm.setCost(costFunction);
-
-    auto directedCandidateRouter = Routing::DirectedCandidateRouter{
-        algorithm,
+    // All routes of this match share one arena, which is released at the end of the match since the returned routes are copied to the heap.
+    auto const streetLengthRouting = Routing::StreetLengthRouting{
         {maxVelocityDifference_, allowSelfIntersection_, maxAngularDeviation_, accountTurningCircleLength_},
         samplingPointList,
+        graph,
         graphEdgeMap,
         streetIndexMap,
         timeList_,
         velocityList_,
-        segmentList_};
+        segmentList_,
+        pathCache_,
+        Types::Routing::makeArena()};
+    auto const & directedCandidateRouter = streetLengthRouting.router();
 
     auto samplingPointRouter
-        = Routing::SamplingPointRouter{directedCandidateRouter, {maxClusteredRoutesLengthDifference_, routeClusterPreference_}, samplingPointList, graphEdgeMap};
+        = Routing::SamplingPointRouter{directedCandidateRouter, {maxClusteredRoutesLengthDifference_, routeClusterPreference_, maxCandidatesPerSamplingPoint_}, samplingPointList, graphEdgeMap};
 
-    auto backtrackRouter = Routing::BacktrackRouter{samplingPointRouter, {maxCandidateBacktrackingDistance_}, samplingPointList, timeList_};
-    auto skipRouter = Routing::SkipRouter{backtrackRouter, {maxSamplingPointSkippingDistance_, samplingPointSkipStrategy_}, samplingPointList, timeList_};
+    auto const samplingPointLocationList = Routing::calcSamplingPointLocations(samplingPointList);
+
+    auto backtrackRouter = Routing::BacktrackRouter{samplingPointRouter, {maxCandidateBacktrackingDistance_}, samplingPointList, samplingPointLocationList, timeList_};
+    auto skipRouter
+        = Routing::SkipRouter{backtrackRouter, {maxSamplingPointSkippingDistance_, samplingPointSkipStrategy_}, samplingPointList, samplingPointLocationList, timeList_};
     auto piecewiseRouter = Routing::PiecewiseRouter{skipRouter, samplingPointList, timeList_};
 
     piecewiseRouter(routeList, routingStatistic);
+    Routing::copyToHeap(routeList);
+
+    APP_LOG(noise) << "path cache: " << streetLengthRouting.pathCacheHits() << " hits, " << streetLengthRouting.pathCacheMisses() << " misses";
 
     return true;
 }
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <AppComponents/Common/Matcher/Routing/PathCache.h>
 #include <AppComponents/Common/Matcher/Routing/Types.h>
 #include <AppComponents/Common/Types/Graph/EdgeMap.h>
 #include <AppComponents/Common/Types/Graph/Graph.h>
@@ -22,6 +23,8 @@
 
 #include <ambpipeline/Filter.h>
 
+#include <memory>
+
 namespace AppComponents::Common::Matcher {
 
 class Router : public ambpipeline::Filter
@@ -39,7 +42,9 @@ public:
         Routing::RouteClusterPreference routeClusterPreference,
         Types::Track::TimeList const & timeList,
         Types::Track::VelocityList const & velocityList,
-        Types::Street::SegmentList const & segmentList);
+        Types::Street::SegmentList const & segmentList,
+        std::shared_ptr<Routing::PathCache> pathCache = nullptr,
+        size_t maxCandidatesPerSamplingPoint = 0);
     bool operator()(
         Types::Routing::SamplingPointList const &,
         Types::Graph::Graph const &,
@@ -61,6 +66,8 @@ private:
     Types::Track::TimeList const & timeList_;
     Types::Track::VelocityList const & velocityList_;
     Types::Street::SegmentList const & segmentList_;
+    std::shared_ptr<Routing::PathCache> const pathCache_;  ///< Shared between runs if given, else a new cache is used per run.
+    size_t const maxCandidatesPerSamplingPoint_;
 };
 
 }  // namespace AppComponents::Common::Matcher
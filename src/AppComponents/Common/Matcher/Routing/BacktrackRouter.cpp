@@ -19,7 +19,6 @@
 
 #include <mutex>
 #include <thread>
-#include <unordered_set>
 
 namespace AppComponents::Common::Matcher::Routing {
 
@@ -28,8 +27,8 @@ struct BacktrackRouter::Session
     explicit Session(
         size_t const sourceSamplingPointIndexMinimum_,
         size_t const targetSamplingPointIndexGoal_,
-        std::unordered_set<size_t> const & skippedSamplingPoints_,
-        Types::Routing::RouteList & routeList_,
+        Generic::IndexSet const & skippedSamplingPoints_,
+        RouteJournal & routeList_,
         SamplingPointRouter::RouteMap & routeMap_,
         Types::Routing::RoutingStatistic & routingStatistic_)
       : sourceSamplingPointIndexMinimum(sourceSamplingPointIndexMinimum_), targetSamplingPointIndexGoal(targetSamplingPointIndexGoal_),
@@ -39,8 +38,8 @@ struct BacktrackRouter::Session
 
     size_t const sourceSamplingPointIndexMinimum;
     size_t const targetSamplingPointIndexGoal;
-    std::unordered_set<size_t> const & skippedSamplingPoints;
-    Types::Routing::RouteList & routeList;
+    Generic::IndexSet const & skippedSamplingPoints;
+    RouteJournal & routeList;
     Types::Routing::RoutingStatistic & routingStatistic;
     SamplingPointRouter::RouteMap & routeMap;
 
@@ -81,10 +80,12 @@ std::tuple<RouteResult, size_t> BacktrackRouter::backtrackProcess(size_t const s
     {
         if (newSourceSamplingPointIndex < session.sourceSamplingPointIndexMinimum)
             return false;
-        return calcApproximateDistanceBetweenSamplingPoints(newSourceSamplingPointIndex, sourceSamplingPoint, samplingPointList_) <= configuration_.maxBacktrackingDistance;
+        // Measured in a straight line like the skipping distance of the `Skipper`.
+        return Core::Common::Geometry::geoDistance(samplingPointLocationList_[newSourceSamplingPointIndex], samplingPointLocationList_[sourceSamplingPoint])
+            <= configuration_.maxBacktrackingDistance;
     };
 
-    auto const routListSnapshot = session.routeList;
+    auto checkpoint = RouteJournal::Checkpoint{session.routeList};
 
     std::optional<size_t> reachedSamplingPoint = sourceSamplingPoint;
 
@@ -93,7 +94,7 @@ std::tuple<RouteResult, size_t> BacktrackRouter::backtrackProcess(size_t const s
         reachedSamplingPoint = Generic::findPreviousAllowed(*reachedSamplingPoint, session.sourceSamplingPointIndexMinimum, session.skippedSamplingPoints);
         if (!reachedSamplingPoint || !backtrackDepthTestFunction(*reachedSamplingPoint))
         {
-            session.routeList = routListSnapshot;
+            checkpoint.rollback();
             return {RouteResult::goalNotReachedButReachable, sourceSamplingPoint};
         }
 
@@ -116,9 +117,9 @@ void BacktrackRouter::operator()(
     size_t const sourceSamplingPointIndexMinimum,
     size_t const sourceSamplingPointIndexStart,
     size_t const targetSamplingPointIndexGoal,
-    std::unordered_set<size_t> const & skippedSamplingPoints,
+    Generic::IndexSet const & skippedSamplingPoints,
     SamplingPointRouter::RouteMap & routeMap,
-    Types::Routing::RouteList & routeList,
+    RouteJournal & routeList,
     Types::Routing::RoutingStatistic & routingStatistic) const
 {
     APP_LOG_LOCATION("BacktrackRouter");
@@ -32,8 +32,12 @@ public:
     };
 
     BacktrackRouter(
-        SamplingPointRouter const & router, Configuration const configuration, Types::Routing::SamplingPointList const & samplingPointList, Types::Track::TimeList const & timeList)
-      : router_(router), configuration_(configuration), samplingPointList_(samplingPointList), timeList_(timeList)
+        SamplingPointRouter const & router,
+        Configuration const configuration,
+        Types::Routing::SamplingPointList const & samplingPointList,
+        Types::Routing::SamplingPointLocationList const & samplingPointLocationList,
+        Types::Track::TimeList const & timeList)
+      : router_(router), configuration_(configuration), samplingPointList_(samplingPointList), samplingPointLocationList_(samplingPointLocationList), timeList_(timeList)
     {
     }
 
@@ -41,15 +45,16 @@ public:
         size_t sourceSamplingPointIndexMinimum,
         size_t sourceSamplingPointIndexStart,
         size_t targetSamplingPointIndexGoal,
-        std::unordered_set<size_t> const & skippedSamplingPoints,
+        Generic::IndexSet const & skippedSamplingPoints,
         SamplingPointRouter::RouteMap & routeMap,
-        Types::Routing::RouteList & routeList,
+        RouteJournal & routeList,
         Types::Routing::RoutingStatistic & routingStatistic) const;
 
 private:
     SamplingPointRouter const & router_;
     Configuration const configuration_;
     Types::Routing::SamplingPointList const & samplingPointList_;
+    Types::Routing::SamplingPointLocationList const & samplingPointLocationList_;
     Types::Track::TimeList const & timeList_;  // TODO: only for debugging
 
     /**
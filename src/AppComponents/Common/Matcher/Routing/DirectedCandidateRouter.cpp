@@ -9,6 +9,10 @@
 #include <AppComponents/Common/Matcher/Routing/DirectedCandidateRouter.h>
 #include <AppComponents/Common/Matcher/Routing/Helper.h>
 
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
 namespace AppComponents::Common::Matcher::Routing {
 
 std::shared_ptr<Types::Routing::Route> DirectedCandidateRouter::operator()(SamplingPointsSelection const samplingPointsSelection) const
@@ -44,18 +48,19 @@ std::shared_ptr<Types::Routing::Route> DirectedCandidateRouter::operator()(Sampl
      *           generated routes
      */
 
-    auto route = std::make_shared<Types::Routing::Route>(Types::Routing::Route{{sourceNode, samplingPointsSelection.source}, {targetNode, samplingPointsSelection.target}, {}});
-    Core::Common::Geometry::LineString newSubRoute;
+    auto route = std::allocate_shared<Types::Routing::Route>(
+        Types::Routing::ArenaAllocator<Types::Routing::Route>{arena_}, Types::Routing::RouteNode{sourceNode, samplingPointsSelection.source},
+        Types::Routing::RouteNode{targetNode, samplingPointsSelection.target}, arena_.get());
 
-    auto addToNewSubRoute = [&](auto const & point)
-    {
-        // The following check is necessary for the first sub point and the end point, but to make the code simplier we call this function for every point.
-        // This check accounts cases where the projected source and end points are on the exact same positions as existing points.
-        if (newSubRoute.empty() || !(newSubRoute.back() == point))
-            newSubRoute.push_back(point);
-    };
+    // Sub routes only reference the street geometries, consecutive duplicate points (f.ex. projected points lying on street points) are skipped by the geometry view.
+    // Only the partial source and target segments need their length measured, routed edges use the precomputed segment length.
+    auto addSubRoute = [&](Core::Graph::Edge const edge, double const cost, Types::Routing::SubRouteGeometry const & geometry)
+    { route->subRoutes.emplace_back(Types::Routing::SubRoute{edge, cost, geometry, geoDistance(geometry)}); };
+    auto addRoutedSubRoute = [&](Core::Graph::Edge const edge, double const cost, size_t const streetIndex, Types::Routing::SubRouteGeometry const & geometry)
+    { route->subRoutes.emplace_back(Types::Routing::SubRoute{edge, cost, geometry, segmentLengthList_.at(streetIndex)}); };
 
-    addToNewSubRoute(sourceCandidate.streetSegmentProjectedPoint);
+    auto const & sourceProjectedPoint = sourceCandidate.streetSegmentProjectedPoint;
+    auto const & targetProjectedPoint = targetCandidate.streetSegmentProjectedPoint;
 
     bool routedOnEdge = false;
     if (sourceEdge == targetEdge)
@@ -75,8 +80,15 @@ std::shared_ptr<Types::Routing::Route> DirectedCandidateRouter::operator()(Sampl
                     && sourceCandidate.streetSegmentProjectedPointNormLength > targetCandidate.streetSegmentProjectedPointNormLength)
                     routedOnEdge = false;
                 if (routedOnEdge)
-                    for (size_t i = sourceCandidate.streetSegmentIndex + 1; i <= targetCandidate.streetSegmentIndex; ++i)
-                        addToNewSubRoute(sourceSegment.geometry.at(i));
+                    addSubRoute(
+                        sourceEdge,
+                        0.0,
+                        {sourceSegment.geometry,
+                         sourceCandidate.streetSegmentIndex + 1,
+                         targetCandidate.streetSegmentIndex - sourceCandidate.streetSegmentIndex,
+                         true,
+                         sourceProjectedPoint,
+                         targetProjectedPoint});
             }
             else
             {
@@ -87,51 +99,41 @@ std::shared_ptr<Types::Routing::Route> DirectedCandidateRouter::operator()(Sampl
                     && sourceCandidate.streetSegmentProjectedPointNormLength < targetCandidate.streetSegmentProjectedPointNormLength)
                     routedOnEdge = false;
                 if (routedOnEdge)
-                    for (size_t i = sourceCandidate.streetSegmentIndex; i > targetCandidate.streetSegmentIndex; --i)
-                        addToNewSubRoute(sourceSegment.geometry.at(i));
+                    addSubRoute(
+                        sourceEdge,
+                        0.0,
+                        {sourceSegment.geometry,
+                         sourceCandidate.streetSegmentIndex,
+                         sourceCandidate.streetSegmentIndex - targetCandidate.streetSegmentIndex,
+                         false,
+                         sourceProjectedPoint,
+                         targetProjectedPoint});
             }
         }
-        if (routedOnEdge)
-        {
-            addToNewSubRoute(targetCandidate.streetSegmentProjectedPoint);
-            route->subRoutes.emplace_back(Types::Routing::SubRoute{sourceEdge, 0.0, newSubRoute, geoDistance(newSubRoute)});
-        }
     }
 
     if (!routedOnEdge)
     {
         if (samplingPointsSelection.source.candidate.consideredForwards)
-            for (size_t i = sourceCandidate.streetSegmentIndex + 1; i < sourceSegment.geometry.size(); ++i)
-                addToNewSubRoute(sourceSegment.geometry.at(i));
+            addSubRoute(
+                sourceEdge,
+                0.0,
+                {sourceSegment.geometry, sourceCandidate.streetSegmentIndex + 1, sourceSegment.geometry.size() - sourceCandidate.streetSegmentIndex - 1, true, sourceProjectedPoint});
         else
-            for (size_t i = sourceCandidate.streetSegmentIndex;; --i)
-            {
-                addToNewSubRoute(sourceSegment.geometry.at(i));
-                if (i == 0)
-                    break;
-            }
-        route->subRoutes.emplace_back(Types::Routing::SubRoute{sourceEdge, 0.0, newSubRoute, geoDistance(newSubRoute)});
-        newSubRoute.clear();
+            addSubRoute(sourceEdge, 0.0, {sourceSegment.geometry, sourceCandidate.streetSegmentIndex, sourceCandidate.streetSegmentIndex + 1, false, sourceProjectedPoint});
 
         if (!(sourceNode == targetNode))
         {
             bool pathFound = false;
-            auto path = algorithm_.run(sourceNode, targetNode);
-            std::list<std::pair<Core::Graph::Edge, double>> path_reversed;
-            for (auto const edge : path)
-                path_reversed.emplace_front(edge.edge(), edge.cost());
-            for (auto const edge : path_reversed)
+            auto const path = shortestPath(sourceNode, targetNode);
+            for (auto const & pathEdge : *path)
             {
-                auto streetEdge = graphEdgeMap_.at(edge.first);
-                auto segment = segmentList_.at(streetEdge.streetIndex);
+                auto const & streetEdge = graphEdgeMap_.at(pathEdge.edge);
+                auto const & segment = segmentList_.at(streetEdge.streetIndex);
                 if (streetEdge.forwards)
-                    for (size_t i = 0; i < segment.geometry.size(); ++i)
-                        addToNewSubRoute(segment.geometry.at(i));
+                    addRoutedSubRoute(pathEdge.edge, pathEdge.cost, streetEdge.streetIndex, {segment.geometry, 0, segment.geometry.size(), true});
                 else
-                    for (size_t i = segment.geometry.size(); i > 0; --i)
-                        addToNewSubRoute(segment.geometry.at(i - 1));
-                route->subRoutes.emplace_back(Types::Routing::SubRoute{edge.first, edge.second, newSubRoute, geoDistance(newSubRoute)});
-                newSubRoute.clear();
+                    addRoutedSubRoute(pathEdge.edge, pathEdge.cost, streetEdge.streetIndex, {segment.geometry, segment.geometry.size() - 1, segment.geometry.size(), false});
                 pathFound = true;
             }
             if (!pathFound)  // the router failed finding a route
@@ -142,13 +144,27 @@ std::shared_ptr<Types::Routing::Route> DirectedCandidateRouter::operator()(Sampl
         }
 
         if (samplingPointsSelection.target.candidate.consideredForwards)
-            for (size_t i = 0; i <= targetCandidate.streetSegmentIndex; ++i)
-                addToNewSubRoute(targetSegment.geometry.at(i));
+            addSubRoute(targetEdge, 0.0, {targetSegment.geometry, 0, targetCandidate.streetSegmentIndex + 1, true, std::nullopt, targetProjectedPoint});
         else
-            for (size_t i = targetSegment.geometry.size(); i > targetCandidate.streetSegmentIndex + 1; --i)
-                addToNewSubRoute(targetSegment.geometry.at(i - 1));
-        addToNewSubRoute(targetCandidate.streetSegmentProjectedPoint);
-        route->subRoutes.emplace_back(Types::Routing::SubRoute{targetEdge, 0.0, newSubRoute, geoDistance(newSubRoute)});
+            addSubRoute(
+                targetEdge,
+                0.0,
+                {targetSegment.geometry,
+                 targetSegment.geometry.size() - 1,
+                 targetSegment.geometry.size() - targetCandidate.streetSegmentIndex - 1,
+                 false,
+                 std::nullopt,
+                 targetProjectedPoint});
+    }
+
+    // The plausibility checks are ordered by their costs, so most implausible routes are rejected before their geometry gets scanned.
+    // The sum of the sub route lengths is a lower bound of the route length, only accounting turning circles requires to walk the points.
+    auto const routeLength = std::accumulate(
+        route->subRoutes.begin(), route->subRoutes.end(), 0.0, [](double sum, auto const & subRoute) { return sum + subRoute.length; });
+    if (!hasPlausibleVelocity(samplingPointsSelection, routeLength, configuration_.accountTurningCircleLength == 0.0))
+    {
+        route->subRoutes.clear();
+        return route;
     }
 
     if (!configuration_.allowSelfIntersection && isSelfIntersectingRoute(*route))
@@ -163,40 +179,103 @@ std::shared_ptr<Types::Routing::Route> DirectedCandidateRouter::operator()(Sampl
         return route;
     }
 
-    if (!timeList_.empty() && !velocityList_.empty())
+    if (configuration_.accountTurningCircleLength != 0.0 && !hasPlausibleVelocity(samplingPointsSelection, routeLength + turningCircleLength(*route), true))
     {
-        double routeLength = 0.0;
-        std::optional<Core::Common::Geometry::Point> lastPoint;
-        std::optional<Core::Common::Geometry::Point> secondLastPoint;
-        for (auto const & subRoute : route->subRoutes)
-        {
-            routeLength += subRoute.length;
+        route->subRoutes.clear();
+        return route;
+    }
 
-            if (configuration_.accountTurningCircleLength != 0.0)
-            {
-                // add turning circle length when routing back the same coordinates
-                assert(!subRoute.route.empty());
-                for (size_t pointIndex = subRoute.route[0] == lastPoint ? 1 : 0; pointIndex < subRoute.route.size(); pointIndex++)
-                {
-                    auto const point = subRoute.route[pointIndex];
-                    if (secondLastPoint == point)
-                        routeLength += configuration_.accountTurningCircleLength;
-                    secondLastPoint = lastPoint;
-                    lastPoint = point;
-                }
-            }
-        }
-        auto const dt = std::chrono::duration_cast<std::chrono::seconds>(timeList_.at(targetSamplingPoint.trackIndex) - timeList_.at(sourceSamplingPoint.trackIndex));
-        auto const realVelocity = (velocityList_.at(targetSamplingPoint.trackIndex) + velocityList_.at(sourceSamplingPoint.trackIndex)) / 2.0;
-        auto const calculatedVelocity = routeLength / dt.count();
-        if (std::abs(calculatedVelocity - realVelocity) > configuration_.maxVelocityDifference)  // TODO: maybe consider street limits and car type
+    return route;
+}
+
+bool DirectedCandidateRouter::hasPlausibleVelocity(SamplingPointsSelection const samplingPointsSelection, double const routeLength, bool const exactLength) const
+{
+    if (timeList_.empty() || velocityList_.empty())
+        return true;
+
+    auto const sourceTrackIndex = samplingPointList_[samplingPointsSelection.source.index].trackIndex;
+    auto const targetTrackIndex = samplingPointList_[samplingPointsSelection.target.index].trackIndex;
+    auto const dt = std::chrono::duration_cast<std::chrono::seconds>(timeList_.at(targetTrackIndex) - timeList_.at(sourceTrackIndex));
+    auto const realVelocity = (velocityList_.at(targetTrackIndex) + velocityList_.at(sourceTrackIndex)) / 2.0;
+    auto const calculatedVelocity = routeLength / dt.count();
+    // TODO: maybe consider street limits and car type
+    if (exactLength)
+        return std::abs(calculatedVelocity - realVelocity) <= configuration_.maxVelocityDifference;
+    // the route may only get longer, so only a too fast route can be rejected
+    return calculatedVelocity - realVelocity <= configuration_.maxVelocityDifference;
+}
+
+double DirectedCandidateRouter::turningCircleLength(Types::Routing::Route const & route) const
+{
+    // add turning circle length when routing back the same coordinates
+    double length = 0.0;
+    std::optional<Core::Common::Geometry::Point> lastPoint;
+    std::optional<Core::Common::Geometry::Point> secondLastPoint;
+    for (auto const & subRoute : route.subRoutes)
+    {
+        assert(!subRoute.route.empty());
+        auto pointIt = subRoute.route.begin();
+        if (subRoute.route.front() == lastPoint)
+            ++pointIt;
+        for (; pointIt != subRoute.route.end(); ++pointIt)
         {
-            route->subRoutes.clear();
-            return route;
+            auto const & point = *pointIt;
+            if (secondLastPoint == point)
+                length += configuration_.accountTurningCircleLength;
+            secondLastPoint = lastPoint;
+            lastPoint = point;
         }
     }
+    return length;
+}
 
-    return route;
+std::shared_ptr<PathCache::Path const> DirectedCandidateRouter::shortestPath(Types::Routing::Node const source, Types::Routing::Node const target) const
+{
+    if (auto path = pathCache_.find({&graph_, source, target, costProfile_}))
+        return path;
+    return cachePath(source, target, algorithm_.findPath(source, target));
+}
+
+std::shared_ptr<PathCache::Path const> DirectedCandidateRouter::cachePath(Types::Routing::Node const source, Types::Routing::Node const target, PathCache::Path && path) const
+{
+    auto cachedPath = std::make_shared<PathCache::Path const>(std::move(path));
+    pathCache_.insert({&graph_, source, target, costProfile_}, cachedPath);
+    return cachedPath;
+}
+
+void DirectedCandidateRouter::prefetchPaths(std::vector<SamplingPointsSelection> const & samplingPointsSelections) const
+{
+    auto targetNodesBySourceNode = std::unordered_map<Types::Routing::Node, std::vector<Types::Routing::Node>>{};
+    for (auto const & samplingPointsSelection : samplingPointsSelections)
+    {
+        auto const nodes = routedNodes(samplingPointsSelection);
+        if (nodes.first == nodes.second)
+            continue;
+        auto & targetNodes = targetNodesBySourceNode[nodes.first];
+        if (std::find(targetNodes.begin(), targetNodes.end(), nodes.second) != targetNodes.end())
+            continue;
+        if (!pathCache_.find({&graph_, nodes.first, nodes.second, costProfile_}))
+            targetNodes.push_back(nodes.second);
+    }
+
+    for (auto const & [sourceNode, targetNodes] : targetNodesBySourceNode)
+        if (!targetNodes.empty())
+            algorithm_.findPaths(
+                sourceNode,
+                targetNodes,
+                [&, &sourceNode = sourceNode, &targetNodes = targetNodes](size_t const index, Core::Graph::Routing::Path && path)
+                { cachePath(sourceNode, targetNodes[index], std::move(path)); });
+}
+
+std::pair<Types::Routing::Node, Types::Routing::Node> DirectedCandidateRouter::routedNodes(SamplingPointsSelection const samplingPointsSelection) const
+{
+    auto const & sourceCandidate = samplingPointList_[samplingPointsSelection.source.index].candidates.at(samplingPointsSelection.source.candidate.index);
+    auto const & targetCandidate = samplingPointList_[samplingPointsSelection.target.index].candidates.at(samplingPointsSelection.target.candidate.index);
+    auto const & sourceGraphTriplePair = streetIndexMap_.at(sourceCandidate.streetIndex);
+    auto const & targetGraphTriplePair = streetIndexMap_.at(targetCandidate.streetIndex);
+    auto const & sourceGraphTriple = samplingPointsSelection.source.candidate.consideredForwards ? sourceGraphTriplePair.forwards.value() : sourceGraphTriplePair.backwards.value();
+    auto const & targetGraphTriple = samplingPointsSelection.target.candidate.consideredForwards ? targetGraphTriplePair.forwards.value() : targetGraphTriplePair.backwards.value();
+    return {std::get<2>(sourceGraphTriple), std::get<0>(targetGraphTriple)};
 }
 
 }  // namespace AppComponents::Common::Matcher::Routing
@@ -8,8 +8,11 @@
 
 #pragma once
 
+#include <AppComponents/Common/Matcher/Routing/PathCache.h>
 #include <AppComponents/Common/Matcher/Routing/Types.h>
 #include <AppComponents/Common/Types/Graph/EdgeMap.h>
+#include <AppComponents/Common/Types/Graph/Graph.h>
+#include <AppComponents/Common/Types/Routing/Arena.h>
 #include <AppComponents/Common/Types/Routing/Edge.h>
 #include <AppComponents/Common/Types/Routing/SamplingPoint.h>
 #include <AppComponents/Common/Types/Street/Segment.h>
@@ -19,6 +22,8 @@
 #include <Core/Graph/Routing/Algorithm.h>
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace AppComponents::Common::Matcher::Routing {
 
@@ -35,22 +40,50 @@ public:
 
     DirectedCandidateRouter(
         Core::Graph::Routing::RoutingAlgorithm & algorithm,
+        Types::Graph::Graph const & graph,
+        PathCache & pathCache,
+        PathCache::CostProfile const costProfile,
         Configuration const configuration,
         Types::Routing::SamplingPointList const & samplingPointList,
         Types::Graph::GraphEdgeMap const & graphEdgeMap,
         Types::Graph::StreetIndexMap const & streetIndexMap,
         Types::Track::TimeList const & timeList,
         Types::Track::VelocityList const & velocityList,
-        Types::Street::SegmentList const & segmentList)
-      : algorithm_(algorithm), configuration_(configuration), samplingPointList_(samplingPointList), graphEdgeMap_(graphEdgeMap), streetIndexMap_(streetIndexMap),
-        timeList_(timeList), velocityList_(velocityList), segmentList_(segmentList)
+        Types::Street::SegmentList const & segmentList,
+        Types::Street::SegmentLengthList const & segmentLengthList,
+        std::shared_ptr<Types::Routing::Arena> arena)
+      : algorithm_(algorithm), graph_(graph), pathCache_(pathCache), costProfile_(costProfile), configuration_(configuration), samplingPointList_(samplingPointList), graphEdgeMap_(graphEdgeMap), streetIndexMap_(streetIndexMap),
+        timeList_(timeList), velocityList_(velocityList), segmentList_(segmentList), segmentLengthList_(segmentLengthList), arena_(std::move(arena))
     {
     }
 
+    /**
+     * Routes candidate pairs (and their direction variants) between the same graph nodes on the same path, looked up in the path cache.
+     */
     std::shared_ptr<Types::Routing::Route> operator()(SamplingPointsSelection samplingPointsSelection) const;
 
+    /**
+     * Adds the paths needed to route the given selections to the path cache, running one one-to-many search per distinct source node.
+     */
+    void prefetchPaths(std::vector<SamplingPointsSelection> const & samplingPointsSelections) const;
+
 private:
+    /// The graph nodes between which the selection is routed: the end of the source edge and the start of the target edge.
+    std::pair<Types::Routing::Node, Types::Routing::Node> routedNodes(SamplingPointsSelection samplingPointsSelection) const;
+
+    std::shared_ptr<PathCache::Path const> cachePath(Types::Routing::Node source, Types::Routing::Node target, PathCache::Path && path) const;
+
+    /// Looks the path up in the path cache and runs the routing algorithm on a miss.
+    std::shared_ptr<PathCache::Path const> shortestPath(Types::Routing::Node source, Types::Routing::Node target) const;
+
+    /// If `exactLength` is false, `routeLength` is only a lower bound of the route length.
+    bool hasPlausibleVelocity(SamplingPointsSelection samplingPointsSelection, double routeLength, bool exactLength) const;
+    double turningCircleLength(Types::Routing::Route const & route) const;
+
     Core::Graph::Routing::RoutingAlgorithm & algorithm_;  // TODO: why does this compile without beeing const? operator()() is const and calls a non-const function on algorithm_.
+    Types::Graph::Graph const & graph_;  ///< The graph `algorithm_` routes on, it scopes the paths in the path cache.
+    PathCache & pathCache_;
+    PathCache::CostProfile const costProfile_;
     Configuration const configuration_;
     Types::Routing::SamplingPointList const & samplingPointList_;
     Types::Graph::GraphEdgeMap const & graphEdgeMap_;
@@ -58,6 +91,8 @@ private:
     Types::Track::TimeList const & timeList_;
     Types::Track::VelocityList const & velocityList_;
     Types::Street::SegmentList const & segmentList_;
+    Types::Street::SegmentLengthList const & segmentLengthList_;
+    std::shared_ptr<Types::Routing::Arena> const arena_;  ///< The routes are allocated from it, the paths are not (they are shared by the path cache).
 };
 
 }  // namespace AppComponents::Common::Matcher::Routing
@@ -10,26 +10,14 @@
 
 namespace AppComponents::Common::Matcher::Routing::Generic {
 
-std::optional<size_t> findPreviousAllowed(size_t value, size_t min, std::unordered_set<size_t> const & blocklist)
+std::optional<size_t> findPreviousAllowed(size_t value, size_t min, IndexSet const & blocklist)
 {
-    size_t i = value;
-    while (i == value || blocklist.find(i) != blocklist.end())
-        if (i > min)
-            i--;
-        else
-            return std::nullopt;
-    return i;
+    return blocklist.findPreviousAbsent(value, min);
 }
 
-std::optional<size_t> findNextAllowed(size_t value, size_t max, std::unordered_set<size_t> const & blocklist)
+std::optional<size_t> findNextAllowed(size_t value, size_t max, IndexSet const & blocklist)
 {
-    size_t i = value;
-    while (i == value || blocklist.find(i) != blocklist.end())
-        if (i < max)
-            i++;
-        else
-            return std::nullopt;
-    return i;
+    return blocklist.findNextAbsent(value, max);
 }
 
 }  // namespace AppComponents::Common::Matcher::Routing::Generic
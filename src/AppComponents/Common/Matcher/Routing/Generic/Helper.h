@@ -8,19 +8,20 @@
 
 #pragma once
 
+#include <AppComponents/Common/Matcher/Routing/Generic/IndexSet.h>
+
 #include <optional>
-#include <unordered_set>
 
 namespace AppComponents::Common::Matcher::Routing::Generic {
 
 /**
  * Find previous sampling point (starting at \p samplingPoint) that was not skipped.
  */
-std::optional<size_t> findPreviousAllowed(size_t samplingPoint, size_t min, std::unordered_set<size_t> const & skippedSamplingPoints);
+std::optional<size_t> findPreviousAllowed(size_t samplingPoint, size_t min, IndexSet const & skippedSamplingPoints);
 
 /**
  * Find next sampling point (starting at \p samplingPoint) samplingPoint that was not skipped.
  */
-std::optional<size_t> findNextAllowed(size_t samplingPoint, size_t max, std::unordered_set<size_t> const & skippedSamplingPoints);
+std::optional<size_t> findNextAllowed(size_t samplingPoint, size_t max, IndexSet const & skippedSamplingPoints);
 
 }  // namespace AppComponents::Common::Matcher::Routing::Generic
@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Matcher/Routing/Generic/IndexSet.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace AppComponents::Common::Matcher::Routing::Generic {
+
+IndexSet::Checkpoint::Checkpoint(IndexSet & set) : set_(set), logSize_(set.log_.size())
+{
+    ++set_.openCheckpoints_;
+}
+
+IndexSet::Checkpoint::~Checkpoint()
+{
+    assert(set_.openCheckpoints_ > 0);
+    if (--set_.openCheckpoints_ == 0)
+        set_.log_.clear();
+}
+
+void IndexSet::Checkpoint::rollback()
+{
+    while (set_.log_.size() > logSize_)
+    {
+        set_.erase(set_.log_.back());
+        set_.log_.pop_back();
+    }
+}
+
+void IndexSet::insert(size_t const index)
+{
+    if (openCheckpoints_ > 0)
+    {
+        if (contains(index))
+            return;
+        log_.push_back(index);
+    }
+    auto const word = index / wordBits;
+    if (word >= words_.size())
+        words_.resize(word + 1, 0);
+    words_[word] |= Word{1} << (index % wordBits);
+}
+
+bool IndexSet::empty() const
+{
+    return std::all_of(words_.begin(), words_.end(), [](Word const word) { return word == 0; });
+}
+
+void IndexSet::clear()
+{
+    std::fill(words_.begin(), words_.end(), 0);
+}
+
+std::optional<size_t> IndexSet::findPreviousAbsent(size_t const value, size_t const min) const
+{
+    if (value <= min)
+        return std::nullopt;
+
+    size_t index = value - 1;
+    while (true)
+    {
+        auto const word = index / wordBits;
+        if (word >= words_.size())
+            return index;
+
+        // absent indices of this word up to and including `index`
+        auto const bit = index % wordBits;
+        auto const mask = bit == wordBits - 1 ? ~Word{0} : (Word{1} << (bit + 1)) - 1;
+        if (auto const absent = ~words_[word] & mask; absent != 0)
+        {
+            auto const found = word * wordBits + (wordBits - 1 - static_cast<size_t>(__builtin_clzll(absent)));
+            return found >= min ? std::optional<size_t>{found} : std::nullopt;
+        }
+
+        if (word == 0 || word * wordBits <= min)
+            return std::nullopt;
+        index = word * wordBits - 1;
+    }
+}
+
+std::optional<size_t> IndexSet::findNextAbsent(size_t const value, size_t const max) const
+{
+    if (value >= max)
+        return std::nullopt;
+
+    size_t index = value + 1;
+    while (index <= max)
+    {
+        auto const word = index / wordBits;
+        if (word >= words_.size())
+            return index;
+
+        // absent indices of this word starting at `index`
+        if (auto const absent = ~words_[word] & (~Word{0} << (index % wordBits)); absent != 0)
+        {
+            auto const found = word * wordBits + static_cast<size_t>(__builtin_ctzll(absent));
+            return found <= max ? std::optional<size_t>{found} : std::nullopt;
+        }
+
+        index = (word + 1) * wordBits;
+    }
+    return std::nullopt;
+}
+
+}  // namespace AppComponents::Common::Matcher::Routing::Generic
@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace AppComponents::Common::Matcher::Routing::Generic {
+
+/**
+ * Dense set of indices, stored as a bitset.
+ *
+ * While a `Checkpoint` is alive, inserted indices are recorded in an undo log (like the routes of a `RouteJournal`),
+ * so rolling back costs O(inserts) instead of copying the whole set.
+ */
+class IndexSet
+{
+public:
+    class Checkpoint
+    {
+    public:
+        explicit Checkpoint(IndexSet & set);
+        ~Checkpoint();
+
+        Checkpoint(Checkpoint const &) = delete;
+        Checkpoint & operator=(Checkpoint const &) = delete;
+
+        /// Restores the set as it was when the checkpoint was created.
+        void rollback();
+
+    private:
+        IndexSet & set_;
+        size_t const logSize_;
+    };
+
+    void insert(size_t index);
+
+    bool contains(size_t index) const
+    {
+        auto const word = index / wordBits;
+        return word < words_.size() && (words_[word] & (Word{1} << (index % wordBits))) != 0;
+    }
+
+    bool empty() const;
+
+    /// Removes all indices but keeps the allocated memory.
+    void clear();
+
+    /**
+     * Find the largest index in [\p min, \p value) that is not contained.
+     */
+    std::optional<size_t> findPreviousAbsent(size_t value, size_t min) const;
+
+    /**
+     * Find the smallest index in (\p value, \p max] that is not contained.
+     */
+    std::optional<size_t> findNextAbsent(size_t value, size_t max) const;
+
+private:
+    using Word = std::uint64_t;
+    static constexpr size_t wordBits = 64;
+
+    void erase(size_t index) { words_[index / wordBits] &= ~(Word{1} << (index % wordBits)); }
+
+    std::vector<Word> words_;
+    std::vector<size_t> log_;  ///< Indices inserted while a checkpoint is open, which were not contained before.
+    size_t openCheckpoints_{0};
+};
+
+}  // namespace AppComponents::Common::Matcher::Routing::Generic
@@ -18,11 +18,11 @@ Skipper::Skipper(
     size_t const target,
     size_t const lowerBound,
     size_t const upperBound,
-    std::unordered_set<size_t> const & blocklist,
-    CostFunction const & costFunction,
+    IndexSet const & blocklist,
+    LocationList const & locationList,
     double const costLimit,
     Strategy const strategy)
-  : lowerBound_(lowerBound), upperBound_(upperBound), blocklist_(blocklist), costFunction_(costFunction), costLimit_(costLimit), strategy_(strategy), lastSource_(source),
+  : lowerBound_(lowerBound), upperBound_(upperBound), blocklist_(blocklist), locationList_(locationList), costLimit_(costLimit), strategy_(strategy), lastSource_(source),
     lastTarget_(target), currentSource_(source), currentTarget_(target)
 {
 }
@@ -43,8 +43,8 @@ bool Skipper::next()
     {
         switch (strategy_)
         {
-            case Strategy::includeEdgeCosts: nextSourceCost = costFunction_(currentSource_, *nextSource); break;
-            case Strategy::excludeEdgeCosts: nextSourceCost = costFunction_(lastSource_, currentSource_); break;
+            case Strategy::includeEdgeCosts: nextSourceCost = costBetween(currentSource_, *nextSource); break;
+            case Strategy::excludeEdgeCosts: nextSourceCost = costBetween(lastSource_, currentSource_); break;
         }
         isNextSourceValid = currentCost_ + nextSourceCost <= costLimit_;
     }
@@ -52,22 +52,22 @@ bool Skipper::next()
     {
         switch (strategy_)
         {
-            case Strategy::includeEdgeCosts: nextTargetCost = costFunction_(currentTarget_, *nextTarget); break;
-            case Strategy::excludeEdgeCosts: nextTargetCost = costFunction_(lastTarget_, currentTarget_); break;
+            case Strategy::includeEdgeCosts: nextTargetCost = costBetween(currentTarget_, *nextTarget); break;
+            case Strategy::excludeEdgeCosts: nextTargetCost = costBetween(lastTarget_, currentTarget_); break;
         }
         isNextTargetValid = currentCost_ + nextTargetCost <= costLimit_;
     }
 
     if (isNextSourceValid && (!isNextTargetValid || nextSourceCost < nextTargetCost))
     {
-        skipped_.insert(currentSource_);
+        skipped_.push_back(currentSource_);
         lastSource_ = currentSource_;
         currentSource_ = *nextSource;
         currentCost_ += nextSourceCost;
     }
     else if (isNextTargetValid)
     {
-        skipped_.insert(currentTarget_);
+        skipped_.push_back(currentTarget_);
         lastTarget_ = currentTarget_;
         currentTarget_ = *nextTarget;
         currentCost_ += nextTargetCost;
@@ -83,16 +83,16 @@ SelectiveSkipper::SelectiveSkipper(
     size_t const target,
     size_t const lowerBound,
     size_t const upperBound,
-    std::unordered_set<size_t> const & blocklist,
-    Skipper::CostFunction const & costFunction,
+    IndexSet const & blocklist,
+    Skipper::LocationList const & locationList,
     double const costLimit,
     Skipper::Strategy const strategy)
   : skippers_({// forwards
-               Skipper{source, target, target, upperBound, blocklist, costFunction, costLimit, strategy},
+               Skipper{source, target, target, upperBound, blocklist, locationList, costLimit, strategy},
                // backwards
-               Skipper{source, target, lowerBound, source, blocklist, costFunction, costLimit, strategy},
+               Skipper{source, target, lowerBound, source, blocklist, locationList, costLimit, strategy},
                // bidirectional
-               Skipper{source, target, lowerBound, upperBound, blocklist, costFunction, costLimit, strategy}})
+               Skipper{source, target, lowerBound, upperBound, blocklist, locationList, costLimit, strategy}})
 {
     // Call `next()` on all skippers but the first, because it is the current skipper
     // and it's `next()` gets called when `SelectiveSkipper::next()` is called.
@@ -8,15 +8,22 @@
 
 #pragma once
 
-#include <functional>
-#include <unordered_set>
+#include <AppComponents/Common/Matcher/Routing/Generic/IndexSet.h>
+
+#include <Core/Common/Geometry/Helper.h>
+#include <Core/Common/Geometry/Types.h>
+
+#include <array>
+#include <cstddef>
+#include <vector>
 
 namespace AppComponents::Common::Matcher::Routing::Generic {
 
 class Skipper
 {
 public:
-    using CostFunction = std::function<double(size_t, size_t)>;
+    /// Location of each index, the cost between two indices is the direct distance of their locations.
+    using LocationList = std::vector<Core::Common::Geometry::Point>;
     enum class Strategy { includeEdgeCosts, excludeEdgeCosts };
 
     Skipper(
@@ -24,8 +31,8 @@ public:
         size_t target,
         size_t lowerBound,
         size_t upperBound,
-        std::unordered_set<size_t> const & blocklist,
-        CostFunction const & costFunction,
+        IndexSet const & blocklist,
+        LocationList const & locationList,
         double costLimit,
         Strategy strategy);
 
@@ -37,15 +44,18 @@ public:
 
     double cost() const { return currentCost_; }
 
-    std::unordered_set<size_t> skipped() const { return skipped_; }
+    /// Skipped indices, in the order they were skipped.
+    std::vector<size_t> const & skipped() const { return skipped_; }
 
     bool next();
 
 private:
+    double costBetween(size_t a, size_t b) const { return Core::Common::Geometry::geoDistance(locationList_[a], locationList_[b]); }
+
     size_t const lowerBound_;
     size_t const upperBound_;
-    std::unordered_set<size_t> const & blocklist_;
-    CostFunction const & costFunction_;
+    IndexSet const & blocklist_;
+    LocationList const & locationList_;
     double const costLimit_;
     Strategy const strategy_;
 
@@ -55,7 +65,7 @@ private:
     size_t currentSource_;
     size_t currentTarget_;
     double currentCost_{0};
-    std::unordered_set<size_t> skipped_;
+    std::vector<size_t> skipped_;
 };
 
 class SelectiveSkipper
@@ -66,8 +76,8 @@ public:
         size_t target,
         size_t lowerBound,
         size_t upperBound,
-        std::unordered_set<size_t> const & blocklist,
-        Skipper::CostFunction const & costFunction,
+        IndexSet const & blocklist,
+        Skipper::LocationList const & locationList,
         double costLimit,
         Skipper::Strategy strategy);
 
@@ -77,7 +87,7 @@ public:
 
     size_t target() const { return selectedSkipper_->target(); }
 
-    std::unordered_set<size_t> skipped() const { return selectedSkipper_->skipped(); }
+    std::vector<size_t> const & skipped() const { return selectedSkipper_->skipped(); }
 
     bool next();
 
@@ -10,10 +10,12 @@
 
 #include <Core/Common/Geometry/Helper.h>
 
+#include <iterator>
+
 namespace AppComponents::Common::Matcher::Routing {
 
 // TODO: Is Core::Common::Geometry::geoLength() a better alternative?
-double geoDistance(Core::Common::Geometry::LineString lineString)
+double geoDistance(Core::Common::Geometry::LineString const & lineString)
 {
     double length = 0.0;
     for (size_t i = 0; i < lineString.size() - 1; ++i)
@@ -21,23 +23,23 @@ double geoDistance(Core::Common::Geometry::LineString lineString)
     return length;
 }
 
-std::optional<std::shared_ptr<Types::Routing::Route>> findPreviousConnectedRoute(size_t startIndex, Types::Routing::RouteList const & routeList)
+double geoDistance(Types::Routing::SubRouteGeometry const & geometry)
 {
-    if (routeList.empty())
-        return std::nullopt;
-    for (size_t i = routeList.size() - 1;; --i)
-    {
-        if (routeList[i]->target.samplingPoint.index == startIndex)
-            return routeList[i];
-        if (routeList[i]->target.samplingPoint.index < startIndex)
-            break;
-        if (i == 0)
-            break;
-    }
-    return std::nullopt;
+    double length = 0.0;
+    if (geometry.empty())
+        return length;
+    auto previous = geometry.begin();
+    for (auto it = std::next(previous); it != geometry.end(); previous = it++)
+        length += Core::Common::Geometry::geoDistance(*previous, *it);
+    return length;
 }
 
-size_t attachToPreviousRoute(Types::Routing::RouteList & routeList, size_t sourceSamplingPointIndex)
+std::optional<std::shared_ptr<Types::Routing::Route>> findPreviousConnectedRoute(size_t startIndex, RouteJournal const & routeList)
+{
+    return routeList.findByTarget(startIndex);
+}
+
+size_t attachToPreviousRoute(RouteJournal & routeList, size_t sourceSamplingPointIndex)
 {
     while (!routeList.empty() && routeList.back()->target.samplingPoint.index > sourceSamplingPointIndex)
         routeList.pop_back();
@@ -49,29 +51,25 @@ bool isSelfIntersectingRoute(Types::Routing::Route const & route)
     auto const & head = route.subRoutes.front().route.front();
     auto const & tail = route.subRoutes.back().route.back();
     for (size_t i = 0; i < route.subRoutes.size(); ++i)
-        for (size_t j = 0; j < route.subRoutes[i].route.size(); ++j)
+    {
+        size_t j = 0;
+        for (auto const & point : route.subRoutes[i].route)
         {
             // check whether the head is contained in itself
-            if (not(i == 0 && j == 0) && route.subRoutes[i].route[j] == head)
+            if (not(i == 0 && j == 0) && point == head)
                 return true;
             // check whether the tail is contained in itself
-            if (not(i == route.subRoutes.size() - 1 && j == route.subRoutes[i].route.size() - 1) && route.subRoutes[i].route[j] == tail)
+            if (not(i == route.subRoutes.size() - 1 && j == route.subRoutes[i].route.size() - 1) && point == tail)
                 return true;
+            ++j;
         }
+    }
     return false;
 }
 
 bool checkMaxAngularDeviation(Types::Routing::Route const & route, double const maxAngularDeviation)
 {
     using namespace Core::Common;
-    std::vector<Geometry::Point> points;
-    for (auto const & subRoute : route.subRoutes)
-    {
-        bool samePoint = not points.empty() && points.back() == subRoute.route.front();
-        points.insert(points.end(), subRoute.route.begin() + (samePoint ? 1 : 0), subRoute.route.end());
-    }
-    if (points.size() < 3)
-        return true;
 
     // Algorithm:
     // - For each angle in [0, 360]
@@ -81,32 +79,57 @@ bool checkMaxAngularDeviation(Types::Routing::Route const & route, double const
     //         - If the pie reaches half the circle, return false.
     // - Return true.
 
-    double left = Geometry::heading(points[0], points[1]);
-    double right = left;
-    double before = left;
+    // The headings are calculated while walking the sub routes, so the route points do not need to be copied.
+    std::optional<Geometry::Point> lastPoint;
+    std::optional<double> before;
+    double left = 0.0;
+    double right = 0.0;
 
-    for (size_t i = 1; i < points.size() - 1; ++i)
+    for (auto const & subRoute : route.subRoutes)
     {
-        double angle = Geometry::normalizeAngle(Geometry::heading(points[i], points[i + 1]));
-        double diff = Geometry::headingDiff(angle, before);
-
-        // Only adjust `left` or `right` if `angle` lies in the empty space.
-        // Rotate everything so that `rights` points to zero,
-        // then between zero and the rotated `left` is the empty space.
-        double angleRotated = Geometry::normalizeAngle(angle - right);
-        double leftRotated = Geometry::normalizeAngle(left - right);
-        if (angleRotated < (leftRotated == 0.0 ? 360.0 : leftRotated))
+        auto pointIt = subRoute.route.begin();
+        if (lastPoint && !subRoute.route.empty() && *lastPoint == subRoute.route.front())
+            ++pointIt;
+        for (; pointIt != subRoute.route.end(); ++pointIt)
         {
-            if (diff <= 0.0)
-                left = angle;
-            else
-                right = angle;
+            auto const & point = *pointIt;
+            if (!lastPoint)
+            {
+                lastPoint = point;
+                continue;
+            }
+
+            if (!before)
+            {
+                left = Geometry::heading(*lastPoint, point);
+                right = left;
+                before = left;
+                lastPoint = point;
+                continue;
+            }
+
+            double angle = Geometry::normalizeAngle(Geometry::heading(*lastPoint, point));
+            double diff = Geometry::headingDiff(angle, *before);
+
+            // Only adjust `left` or `right` if `angle` lies in the empty space.
+            // Rotate everything so that `rights` points to zero,
+            // then between zero and the rotated `left` is the empty space.
+            double angleRotated = Geometry::normalizeAngle(angle - right);
+            double leftRotated = Geometry::normalizeAngle(left - right);
+            if (angleRotated < (leftRotated == 0.0 ? 360.0 : leftRotated))
+            {
+                if (diff <= 0.0)
+                    left = angle;
+                else
+                    right = angle;
+            }
+
+            if (Geometry::normalizeAngle(right + (360.0 - left)) > maxAngularDeviation)
+                return false;
+
+            before = angle;
+            lastPoint = point;
         }
-
-        if (Geometry::normalizeAngle(right + (360.0 - left)) > maxAngularDeviation)
-            return false;
-
-        before = angle;
     }
 
     return true;
@@ -119,4 +142,20 @@ double calcApproximateDistanceBetweenSamplingPoints(size_t const sourceSamplingP
         samplingPointList.at(targetSamplingPoint).candidates.front().streetSegmentProjectedPoint);
 }
 
+Types::Routing::SamplingPointLocationList calcSamplingPointLocations(Types::Routing::SamplingPointList const & samplingPointList)
+{
+    Types::Routing::SamplingPointLocationList locations;
+    locations.reserve(samplingPointList.size());
+    for (auto const & samplingPoint : samplingPointList)
+        locations.push_back(samplingPoint.candidates.front().streetSegmentProjectedPoint);
+    return locations;
+}
+
+void copyToHeap(Types::Routing::RouteList & routeList)
+{
+    // Copying a pmr vector does not propagate its allocator, so the sub routes are copied to the default resource.
+    for (auto & route : routeList)
+        route = std::make_shared<Types::Routing::Route>(*route);
+}
+
 }  // namespace AppComponents::Common::Matcher::Routing
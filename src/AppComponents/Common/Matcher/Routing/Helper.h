@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <AppComponents/Common/Matcher/Routing/RouteJournal.h>
 #include <AppComponents/Common/Types/Routing/Edge.h>
 #include <AppComponents/Common/Types/Routing/SamplingPoint.h>
 
@@ -33,11 +34,12 @@ inline std::string routeResultToString(RouteResult const result)
     return std::to_string(static_cast<size_t>(result));
 }
 
-double geoDistance(Core::Common::Geometry::LineString lineString);
+double geoDistance(Core::Common::Geometry::LineString const & lineString);
+double geoDistance(Types::Routing::SubRouteGeometry const & geometry);
 
-std::optional<std::shared_ptr<Types::Routing::Route>> findPreviousConnectedRoute(size_t startIndex, Types::Routing::RouteList const & routeList);
+std::optional<std::shared_ptr<Types::Routing::Route>> findPreviousConnectedRoute(size_t startIndex, RouteJournal const & routeList);
 
-size_t attachToPreviousRoute(Types::Routing::RouteList & routeList, size_t sourceSamplingPointIndex);
+size_t attachToPreviousRoute(RouteJournal & routeList, size_t sourceSamplingPointIndex);
 
 bool isSelfIntersectingRoute(Types::Routing::Route const & route);
 
@@ -46,4 +48,14 @@ bool checkMaxAngularDeviation(Types::Routing::Route const & route, double maxAng
 double
 calcApproximateDistanceBetweenSamplingPoints(size_t const sourceSamplingPoint, size_t const targetSamplingPoint, Types::Routing::SamplingPointList const & samplingPointList);
 
+/**
+ * Looks up the points `calcApproximateDistanceBetweenSamplingPoints` measures between.
+ */
+Types::Routing::SamplingPointLocationList calcSamplingPointLocations(Types::Routing::SamplingPointList const & samplingPointList);
+
+/**
+ * Replaces the routes by copies on the default heap, so the arena they were allocated from (with all rejected routes of the match) can be released.
+ */
+void copyToHeap(Types::Routing::RouteList & routeList);
+
 }  // namespace AppComponents::Common::Matcher::Routing
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Matcher/Routing/PathCache.h>
+
+namespace AppComponents::Common::Matcher::Routing {
+
+std::shared_ptr<PathCache::Path const> PathCache::find(Key const & key)
+{
+    auto const lock = std::lock_guard{mutex_};
+    auto it = index_.find(key);
+    if (it == index_.end())
+    {
+        ++misses_;
+        return nullptr;
+    }
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+}
+
+void PathCache::insert(Key const & key, std::shared_ptr<Path const> path)
+{
+    if (capacity_ == 0)
+        return;
+
+    auto const lock = std::lock_guard{mutex_};
+    if (auto it = index_.find(key); it != index_.end())
+    {
+        it->second->second = std::move(path);
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return;
+    }
+
+    if (entries_.size() >= capacity_)
+    {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+    entries_.emplace_front(key, std::move(path));
+    index_.emplace(key, entries_.begin());
+}
+
+void PathCache::clear()
+{
+    auto const lock = std::lock_guard{mutex_};
+    entries_.clear();
+    index_.clear();
+    hits_ = 0;
+    misses_ = 0;
+}
+
+size_t PathCache::size() const
+{
+    auto const lock = std::lock_guard{mutex_};
+    return entries_.size();
+}
+
+size_t PathCache::hits() const
+{
+    auto const lock = std::lock_guard{mutex_};
+    return hits_;
+}
+
+size_t PathCache::misses() const
+{
+    auto const lock = std::lock_guard{mutex_};
+    return misses_;
+}
+
+}  // namespace AppComponents::Common::Matcher::Routing
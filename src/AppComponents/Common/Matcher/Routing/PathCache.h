@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <Core/Graph/Graph.h>
+#include <Core/Graph/Routing/Path.h>
+
+#include <Generic/Hash/MakeHashable.h>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace AppComponents::Common::Matcher::Routing {
+
+/**
+ * Bounded least-recently-used cache of shortest paths between graph nodes.
+ *
+ * Paths are keyed by the graph they were found on, so routers (f.ex. of several tracks) may share a cache even if they route on different graphs.
+ * A graph is identified by its address: clear the cache when a graph is modified, or destroyed while another one may take its place.
+ * Thread-safe, so routers running in parallel may share a cache.
+ */
+class PathCache
+{
+public:
+    /// Identifies the edge cost function the paths were calculated with.
+    enum class CostProfile { geoDistance };
+
+    /// Edges and their accumulated costs from the source node to the target node, empty if the target is not reachable.
+    using Path = Core::Graph::Routing::Path;
+
+    struct Key
+    {
+        Core::Graph::Graph const * graph;
+        Core::Graph::Node source;
+        Core::Graph::Node target;
+        CostProfile costProfile;
+
+        bool operator==(Key const & other) const
+        {
+            return graph == other.graph && source == other.source && target == other.target && costProfile == other.costProfile;
+        }
+    };
+
+    static constexpr size_t defaultCapacity = 1 << 16;
+
+    explicit PathCache(size_t capacity = defaultCapacity) : capacity_(capacity) {}
+
+    /// @return The cached path or `nullptr`.
+    std::shared_ptr<Path const> find(Key const & key);
+
+    void insert(Key const & key, std::shared_ptr<Path const> path);
+
+    void clear();
+
+    size_t size() const;
+    size_t capacity() const { return capacity_; }
+    size_t hits() const;
+    size_t misses() const;
+
+private:
+    using Entry = std::pair<Key, std::shared_ptr<Path const>>;
+    using EntryList = std::list<Entry>;
+
+    struct KeyHash
+    {
+        size_t operator()(Key const & key) const
+        {
+            size_t seed = 0;
+            hash_combine(seed, key.graph, key.source, key.target, static_cast<size_t>(key.costProfile));
+            return seed;
+        }
+    };
+
+    size_t const capacity_;
+    mutable std::mutex mutex_;  ///< Guards all of the following members.
+    EntryList entries_;  ///< Most recently used first.
+    std::unordered_map<Key, EntryList::iterator, KeyHash> index_;
+    size_t hits_{0};
+    size_t misses_{0};
+};
+
+}  // namespace AppComponents::Common::Matcher::Routing
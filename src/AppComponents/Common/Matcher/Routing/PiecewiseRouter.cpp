@@ -9,6 +9,7 @@
 #include <AppComponents/Common/Matcher/Routing/Comparators.h>
 #include <AppComponents/Common/Matcher/Routing/Helper.h>
 #include <AppComponents/Common/Matcher/Routing/PiecewiseRouter.h>
+#include <AppComponents/Common/Matcher/Routing/RouteJournal.h>
 #include <AppComponents/Common/Matcher/Routing/SkipRouter.h>
 
 #include <Core/Common/Time/Helper.h>  // TODO: only for debugging
@@ -22,13 +23,15 @@ PiecewiseRouter::PiecewiseRouter(SkipRouter const & router, Types::Routing::Samp
 {
 }
 
-bool PiecewiseRouter::operator()(Types::Routing::RouteList & routeList, Types::Routing::RoutingStatistic & routingStatistic)
+bool PiecewiseRouter::operator()(Types::Routing::RouteList & routes, Types::Routing::RoutingStatistic & routingStatistic)
 {
     APP_LOG_LOCATION("PiecewiseRouter");
 
     // TODO: only for debugging
     auto getTime = [&](size_t const samplingPoint) { return Core::Common::Time::toString(timeList_[samplingPointList_[samplingPoint].trackIndex], "%H:%M:%S"); };
 
+    auto routeList = RouteJournal{routes};
+
     size_t sourceSamplingPointIndex = 0;
     while (!samplingPointList_.empty() && sourceSamplingPointIndex < samplingPointList_.size() - 1)
     {
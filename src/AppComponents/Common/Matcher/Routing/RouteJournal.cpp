@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Matcher/Routing/RouteJournal.h>
+
+#include <cassert>
+#include <utility>
+
+namespace AppComponents::Common::Matcher::Routing {
+
+RouteJournal::Checkpoint::Checkpoint(RouteJournal & journal) : journal_(journal), logSize_(journal.log_.size())
+{
+    ++journal_.openCheckpoints_;
+}
+
+RouteJournal::Checkpoint::~Checkpoint()
+{
+    assert(journal_.openCheckpoints_ > 0);
+    if (--journal_.openCheckpoints_ == 0)
+        journal_.log_.clear();
+}
+
+void RouteJournal::Checkpoint::rollback()
+{
+    auto & journal = journal_;
+    while (journal.log_.size() > logSize_)
+    {
+        auto change = std::move(journal.log_.back());
+        journal.log_.pop_back();
+        if (change.poppedRoute)
+        {
+            journal.routes_.push_back(std::move(change.poppedRoute));
+            journal.index(journal.routes_.size() - 1);
+        }
+        else
+        {
+            journal.unindex(journal.routes_.size() - 1);
+            journal.routes_.pop_back();
+        }
+    }
+}
+
+RouteJournal::RouteJournal(Types::Routing::RouteList & routeList) : routes_(routeList)
+{
+    for (size_t position = 0; position < routes_.size(); ++position)
+        index(position);
+}
+
+void RouteJournal::push_back(RoutePtr route)
+{
+    routes_.push_back(std::move(route));
+    index(routes_.size() - 1);
+    if (openCheckpoints_ > 0)
+        log_.push_back({});
+}
+
+void RouteJournal::pop_back()
+{
+    assert(!routes_.empty());
+    unindex(routes_.size() - 1);
+    if (openCheckpoints_ > 0)
+        log_.push_back({std::move(routes_.back())});
+    routes_.pop_back();
+}
+
+std::optional<RouteJournal::RoutePtr> RouteJournal::findByTarget(size_t const samplingPointIndex) const
+{
+    if (samplingPointIndex >= positionByTarget_.size() || positionByTarget_[samplingPointIndex] == 0)
+        return std::nullopt;
+    return routes_[positionByTarget_[samplingPointIndex] - 1];
+}
+
+void RouteJournal::index(size_t const position)
+{
+    auto const target = routes_[position]->target.samplingPoint.index;
+    if (target >= positionByTarget_.size())
+        positionByTarget_.resize(target + 1, 0);
+    positionByTarget_[target] = position + 1;
+}
+
+void RouteJournal::unindex(size_t const position)
+{
+    auto const target = routes_[position]->target.samplingPoint.index;
+    if (positionByTarget_[target] == position + 1)
+        positionByTarget_[target] = 0;
+}
+
+}  // namespace AppComponents::Common::Matcher::Routing
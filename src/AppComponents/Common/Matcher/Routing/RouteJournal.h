@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <AppComponents/Common/Types/Routing/Edge.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace AppComponents::Common::Matcher::Routing {
+
+/**
+ * Route list under construction with checkpoint/rollback semantics.
+ *
+ * While a `Checkpoint` is alive, every change is recorded in an undo log, so rolling back costs O(changes) instead of copying the whole list.
+ * Routes are additionally indexed by their target sampling point.
+ */
+class RouteJournal
+{
+public:
+    using RoutePtr = std::shared_ptr<Types::Routing::Route>;
+
+    class Checkpoint
+    {
+    public:
+        explicit Checkpoint(RouteJournal & journal);
+        ~Checkpoint();
+
+        Checkpoint(Checkpoint const &) = delete;
+        Checkpoint & operator=(Checkpoint const &) = delete;
+
+        /// Restores the route list as it was when the checkpoint was created.
+        void rollback();
+
+    private:
+        RouteJournal & journal_;
+        size_t const logSize_;
+    };
+
+    explicit RouteJournal(Types::Routing::RouteList & routeList);
+
+    Types::Routing::RouteList const & routes() const { return routes_; }
+    bool empty() const { return routes_.empty(); }
+    size_t size() const { return routes_.size(); }
+    RoutePtr const & back() const { return routes_.back(); }
+
+    void push_back(RoutePtr route);
+    void pop_back();
+
+    /// Returns the route ending at sampling point \p samplingPointIndex.
+    std::optional<RoutePtr> findByTarget(size_t samplingPointIndex) const;
+
+private:
+    struct Change
+    {
+        RoutePtr poppedRoute;  ///< Empty if a route was pushed.
+    };
+
+    void index(size_t position);
+    void unindex(size_t position);
+
+    Types::Routing::RouteList & routes_;
+    std::vector<Change> log_;
+    size_t openCheckpoints_{0};
+    std::vector<size_t> positionByTarget_;  ///< Position + 1 of the route ending at a sampling point, 0 if there is none.
+};
+
+}  // namespace AppComponents::Common::Matcher::Routing
@@ -11,127 +11,193 @@
 
 #include <Core/Common/Geometry/Helper.h>
 
-#include <mutex>
-#include <thread>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <set>
 #include <unordered_set>
 
 namespace AppComponents::Common::Matcher::Routing {
 
 namespace {
 
-    using ClusteredRouteMatrix = std::vector<std::set<std::shared_ptr<Types::Routing::Route>, BestSimilarRouteComparator>>;
-    using SamplingPointCandidateSelectionPair = std::pair<Types::Routing::SamplingPointCandidateSelection, Types::Routing::SamplingPointCandidateSelection>;
+    using ClusteredRouteMatrix = std::pmr::vector<std::pmr::set<std::shared_ptr<Types::Routing::Route>, BestSimilarRouteComparator>>;
+    using ConsideredForwardsPair = std::pair<bool, bool>;
 
-    std::vector<SamplingPointCandidateSelectionPair> selectCandidates(
-        size_t const sourceSamplingPointIndex,
-        size_t const targetSamplingPointIndex,
-        Types::Routing::RouteList const & routeList,
-        Types::Routing::SamplingPointList const & samplingPointList)
+    /**
+     * Selects the direction variants to route for a candidate pair.
+     * @param sourceConsideredForwardsOptional The source direction, if already chosen by the previous connected route.
+     */
+    std::vector<ConsideredForwardsPair> selectDirections(
+        Types::Routing::SamplingPointCandidate const & sourceCandidate,
+        Types::Routing::SamplingPointCandidate const & targetCandidate,
+        std::optional<bool> const sourceConsideredForwardsOptional)
     {
-        auto const & sourceSamplingPoint = samplingPointList[sourceSamplingPointIndex];
-        auto const & targetSamplingPoint = samplingPointList[targetSamplingPointIndex];
-        auto selections = std::vector<SamplingPointCandidateSelectionPair>{};
-        size_t sourceCandidateTestBegin;
-        size_t sourceCandidateTestEnd;
-        std::optional<bool> sourceCandidateTestConsideredForwardsOptional;
-        auto previousConnectedRoute = findPreviousConnectedRoute(sourceSamplingPointIndex, routeList);
-        if (!previousConnectedRoute)
+        std::vector<ConsideredForwardsPair> consideredForwardsPairs;
+        if (not sourceConsideredForwardsOptional)
         {
-            sourceCandidateTestBegin = 0;
-            sourceCandidateTestEnd = sourceSamplingPoint.candidates.size();
+            bool sourceConsideredForwards = sourceCandidate.streetSegmentTravelDirection == Types::Street::TravelDirection::forwards;
+            bool targetConsideredForwards = targetCandidate.streetSegmentTravelDirection == Types::Street::TravelDirection::forwards;
+            if (sourceCandidate.streetSegmentTravelDirection != Types::Street::TravelDirection::both)
+            {
+                if (targetCandidate.streetSegmentTravelDirection != Types::Street::TravelDirection::both)
+                {
+                    consideredForwardsPairs.emplace_back(sourceConsideredForwards, targetConsideredForwards);
+                }
+                else
+                {
+                    consideredForwardsPairs.emplace_back(sourceConsideredForwards, true);
+                    consideredForwardsPairs.emplace_back(sourceConsideredForwards, false);
+                }
+            }
+            else
+            {
+                if (targetCandidate.streetSegmentTravelDirection != Types::Street::TravelDirection::both)
+                {
+                    consideredForwardsPairs.emplace_back(true, targetConsideredForwards);
+                    consideredForwardsPairs.emplace_back(false, targetConsideredForwards);
+                }
+                else
+                {
+                    consideredForwardsPairs.emplace_back(true, true);
+                    consideredForwardsPairs.emplace_back(false, false);
+                    consideredForwardsPairs.emplace_back(true, false);
+                    consideredForwardsPairs.emplace_back(false, true);
+                }
+            }
         }
         else
         {
-            sourceCandidateTestBegin = (*previousConnectedRoute)->target.samplingPoint.candidate.index;
-            sourceCandidateTestEnd = sourceCandidateTestBegin + 1;
-            sourceCandidateTestConsideredForwardsOptional = (*previousConnectedRoute)->target.samplingPoint.candidate.consideredForwards;
+            bool sourceConsideredForwards = *sourceConsideredForwardsOptional;
+
+            // Direction may have been choosen from previous sampling point, so check for validity and correct if necessary.
+            if (sourceConsideredForwards && sourceCandidate.streetSegmentTravelDirection == Types::Street::TravelDirection::backwards)
+                sourceConsideredForwards = false;
+            if (!sourceConsideredForwards && sourceCandidate.streetSegmentTravelDirection == Types::Street::TravelDirection::forwards)
+                sourceConsideredForwards = true;
+
+            bool targetConsideredForwards = targetCandidate.streetSegmentTravelDirection == Types::Street::TravelDirection::forwards;
+            if (targetCandidate.streetSegmentTravelDirection != Types::Street::TravelDirection::both)
+            {
+                consideredForwardsPairs.emplace_back(sourceConsideredForwards, targetConsideredForwards);
+            }
+            else
+            {
+                consideredForwardsPairs.emplace_back(sourceConsideredForwards, true);
+                consideredForwardsPairs.emplace_back(sourceConsideredForwards, false);
+            }
+        }
+
+        return consideredForwardsPairs;
+    }
+
+    /**
+     * Lazily enumerates candidate pairs, best-first or source candidate by source candidate.
+     *
+     * The candidates of a sampling point are ordered by the `SamplingPointFinder`, so their index is their rank.
+     * Best-first, the pairs are enumerated by increasing rank sum (one "diagonal" after the other), ties by increasing source rank.
+     * This is the order of `BestSimilarRouteComparator`, so a cluster's best route is always the first one added to it.
+     * Routes are clustered in the order of the enumeration, and as similarity is not transitive,
+     * clustering best-first may form other clusters than clustering source candidate by source candidate.
+     */
+    class CandidatePairEnumerator
+    {
+    public:
+        CandidatePairEnumerator(size_t const sourceBegin, size_t const sourceCount, size_t const targetCount, bool const bestFirst)
+          : sourceBegin_(sourceBegin), sourceCount_(sourceCount), targetCount_(targetCount), bestFirst_(bestFirst)
+        {
         }
-        size_t targetCandidateTestBegin = 0;
-        size_t targetCandidateTestEnd = targetSamplingPoint.candidates.size();
-        for (size_t sourceCandidateIndex = sourceCandidateTestBegin; sourceCandidateIndex < sourceCandidateTestEnd; ++sourceCandidateIndex)
+
+        size_t diagonalCount() const { return sourceCount_ == 0 || targetCount_ == 0 ? 0 : sourceCount_ + targetCount_ - 1; }
+
+        /// Rank sum of the pair returned last, only if enumerating best-first.
+        size_t diagonal() const { return diagonal_; }
+
+        /// @return The next source and target candidate index.
+        std::optional<std::pair<size_t, size_t>> next()
         {
-            for (size_t targetCandidateIndex = targetCandidateTestBegin; targetCandidateIndex < targetCandidateTestEnd; ++targetCandidateIndex)
+            if (!bestFirst_)
             {
-                auto const & sourceCandidate = sourceSamplingPoint.candidates.at(sourceCandidateIndex);
-                auto const & targetCandidate = targetSamplingPoint.candidates.at(targetCandidateIndex);
-
-                std::vector<std::pair<bool, bool>> consideredForwardsPairs;
-                if (not sourceCandidateTestConsideredForwardsOptional)
+                if (sourceRank_ >= sourceCount_ || targetCount_ == 0)
+                    return std::nullopt;
+                auto const pair = std::make_pair(sourceBegin_ + sourceRank_, targetRank_);
+                if (++targetRank_ == targetCount_)
                 {
-                    bool sourceConsideredForwards = sourceCandidate.streetSegmentTravelDirection == Types::Street::TravelDirection::forwards;
-                    bool targetConsideredForwards = targetCandidate.streetSegmentTravelDirection == Types::Street::TravelDirection::forwards;
-                    if (sourceCandidate.streetSegmentTravelDirection != Types::Street::TravelDirection::both)
-                    {
-                        if (targetCandidate.streetSegmentTravelDirection != Types::Street::TravelDirection::both)
-                        {
-                            consideredForwardsPairs.emplace_back(sourceConsideredForwards, targetConsideredForwards);
-                        }
-                        else
-                        {
-                            consideredForwardsPairs.emplace_back(sourceConsideredForwards, true);
-                            consideredForwardsPairs.emplace_back(sourceConsideredForwards, false);
-                        }
-                    }
-                    else
-                    {
-                        if (targetCandidate.streetSegmentTravelDirection != Types::Street::TravelDirection::both)
-                        {
-                            consideredForwardsPairs.emplace_back(true, targetConsideredForwards);
-                            consideredForwardsPairs.emplace_back(false, targetConsideredForwards);
-                        }
-                        else
-                        {
-                            consideredForwardsPairs.emplace_back(true, true);
-                            consideredForwardsPairs.emplace_back(false, false);
-                            consideredForwardsPairs.emplace_back(true, false);
-                            consideredForwardsPairs.emplace_back(false, true);
-                        }
-                    }
+                    targetRank_ = 0;
+                    ++sourceRank_;
                 }
-                else
+                return pair;
+            }
+            while (diagonal_ < diagonalCount())
+            {
+                if (sourceRank_ <= std::min(diagonal_, sourceCount_ - 1))
                 {
-                    bool sourceConsideredForwards = *sourceCandidateTestConsideredForwardsOptional;
-
-                    // Direction may have been choosen from previous sampling point, so check for validity and correct if necessary.
-                    if (sourceConsideredForwards && sourceCandidate.streetSegmentTravelDirection == Types::Street::TravelDirection::backwards)
-                        sourceConsideredForwards = false;
-                    if (!sourceConsideredForwards && sourceCandidate.streetSegmentTravelDirection == Types::Street::TravelDirection::forwards)
-                        sourceConsideredForwards = true;
-
-                    bool targetConsideredForwards = targetCandidate.streetSegmentTravelDirection == Types::Street::TravelDirection::forwards;
-                    if (targetCandidate.streetSegmentTravelDirection != Types::Street::TravelDirection::both)
-                    {
-                        consideredForwardsPairs.emplace_back(sourceConsideredForwards, targetConsideredForwards);
-                    }
-                    else
-                    {
-                        consideredForwardsPairs.emplace_back(sourceConsideredForwards, true);
-                        consideredForwardsPairs.emplace_back(sourceConsideredForwards, false);
-                    }
+                    auto const pair = std::make_pair(sourceBegin_ + sourceRank_, diagonal_ - sourceRank_);
+                    ++sourceRank_;
+                    return pair;
                 }
-
-                for (auto const & consideredForwardsPair : consideredForwardsPairs)
-                    selections.emplace_back(
-                        SamplingPointCandidateSelectionPair{{sourceCandidateIndex, consideredForwardsPair.first}, {targetCandidateIndex, consideredForwardsPair.second}});
+                ++diagonal_;
+                sourceRank_ = diagonal_ >= targetCount_ ? diagonal_ - targetCount_ + 1 : 0;
             }
+            return std::nullopt;
         }
-        return selections;
+
+    private:
+        size_t const sourceBegin_;
+        size_t const sourceCount_;
+        size_t const targetCount_;
+        bool const bestFirst_;
+        size_t diagonal_{0};
+        size_t sourceRank_{0};
+        size_t targetRank_{0};  ///< Only used if not enumerating best-first.
+    };
+
+    /**
+     * Lower bounds of the route length of all candidate pairs starting at each diagonal of a `CandidatePairEnumerator`.
+     *
+     * A route is never shorter than the geo distance between its projected source and target points.
+     */
+    std::vector<double> calcRemainingLengthLowerBounds(
+        Types::Routing::SamplingPoint const & sourceSamplingPoint,
+        size_t const sourceBegin,
+        size_t const sourceCount,
+        Types::Routing::SamplingPoint const & targetSamplingPoint,
+        size_t const targetCount)
+    {
+        auto lowerBounds = std::vector<double>(sourceCount + targetCount, std::numeric_limits<double>::infinity());
+        if (lowerBounds.empty())
+            return lowerBounds;
+        for (size_t sourceRank = 0; sourceRank < sourceCount; ++sourceRank)
+            for (size_t targetRank = 0; targetRank < targetCount; ++targetRank)
+            {
+                auto const distance = Core::Common::Geometry::geoDistance(
+                    sourceSamplingPoint.candidates[sourceBegin + sourceRank].streetSegmentProjectedPoint,
+                    targetSamplingPoint.candidates[targetRank].streetSegmentProjectedPoint);
+                lowerBounds[sourceRank + targetRank] = std::min(lowerBounds[sourceRank + targetRank], distance);
+            }
+        for (size_t diagonal = lowerBounds.size() - 1; diagonal > 0; --diagonal)
+            lowerBounds[diagonal - 1] = std::min(lowerBounds[diagonal - 1], lowerBounds[diagonal]);
+        return lowerBounds;
     }
 
-    std::shared_ptr<Types::Routing::Route> getBestRoute(std::shared_ptr<ClusteredRouteMatrix> const & clusteredRouteMatrix, RouteClusterPreference const routeClusterPreference)
+    std::shared_ptr<Types::Routing::Route> getBestRoute(ClusteredRouteMatrix const & clusteredRouteMatrix, RouteClusterPreference const routeClusterPreference)
     {
-        if (clusteredRouteMatrix->empty())
+        if (clusteredRouteMatrix.empty())
             return nullptr;
 
-        auto bestRoutes = std::set<std::shared_ptr<Types::Routing::Route>, BestRouteComparator>{routeClusterPreference};
-        for (auto const & clusteredRoutes : *clusteredRouteMatrix)
-            bestRoutes.insert(*clusteredRoutes.begin());
-
-        return *bestRoutes.begin();
+        // The first of equally good routes wins, like when collecting them in a set.
+        auto const comparator = BestRouteComparator{routeClusterPreference};
+        auto const bestClusteredRoutes = std::min_element(
+            clusteredRouteMatrix.begin(), clusteredRouteMatrix.end(), [&](auto const & a, auto const & b) { return comparator(*a.begin(), *b.begin()); });
+        return *bestClusteredRoutes->begin();
     }
 
-    std::shared_ptr<Types::Routing::Route>
-    routeCached(SamplingPointsSelection const samplingPointsSelection, DirectedCandidateRouter const & router, SamplingPointRouter::RouteMap & routeMap)
+    std::shared_ptr<Types::Routing::Route> routeCached(
+        SamplingPointsSelection const samplingPointsSelection,
+        DirectedCandidateRouter const & router,
+        SamplingPointRouter::RouteMap & routeMap)
     {
         if (auto it = routeMap.find(samplingPointsSelection); it != routeMap.end())
             return it->second;
@@ -142,91 +208,106 @@ namespace {
         }
     }
 
-    std::shared_ptr<ClusteredRouteMatrix>
-    cluster(std::vector<std::shared_ptr<Types::Routing::Route>> const & routes, double const maxLengthDifference, Types::Graph::GraphEdgeMap const & graphEdgeMap)
+    void addToCluster(
+        ClusteredRouteMatrix & clusteredRouteMatrix,
+        std::shared_ptr<Types::Routing::Route> const & route,
+        double const maxLengthDifference,
+        Types::Graph::GraphEdgeMap const & graphEdgeMap)
     {
-        auto clusteredRouteMatrix = std::make_shared<ClusteredRouteMatrix>();
-
-        if (routes.empty())
+        for (auto & clusteredRoutes : clusteredRouteMatrix)
         {
-            return clusteredRouteMatrix;
-        }
-
-        for (auto const & route : routes)
-        {
-            bool foundCluster = false;
-            for (auto & clusteredRoutes : *clusteredRouteMatrix)
-            {
-                auto const & firstRoute
-                    = **clusteredRoutes.begin();  // If it is similar to one route, it should be also similar to all the others, so we only check against the first in the cluster.
-                if (isSimilar(*route, firstRoute, maxLengthDifference, graphEdgeMap))
-                {
-                    clusteredRoutes.insert(route);
-                    foundCluster = true;
-                    break;
-                }
-            }
-            if (!foundCluster)
+            auto const & firstRoute
+                = **clusteredRoutes.begin();  // If it is similar to one route, it should be also similar to all the others, so we only check against the first in the cluster.
+            if (isSimilar(*route, firstRoute, maxLengthDifference, graphEdgeMap))
             {
-                clusteredRouteMatrix->emplace_back();
-                clusteredRouteMatrix->back().insert(route);
+                clusteredRoutes.insert(route);
+                return;
             }
         }
-
-        return clusteredRouteMatrix;
+        clusteredRouteMatrix.emplace_back();
+        clusteredRouteMatrix.back().insert(route);
     }
 
 }  // namespace
 
-std::vector<std::shared_ptr<Types::Routing::Route>> SamplingPointRouter::calcPossibleRoutes(
+std::shared_ptr<Types::Routing::Route> SamplingPointRouter::calcBestRoute(
     size_t const sourceSamplingPointIndex,
     size_t const targetSamplingPointIndex,
     VisitedRouteSet & visitedRouteSet,
     RouteMap & routeMap,
     Types::Routing::RoutingStatistic & routingStatistic,
-    Types::Routing::RouteList const & routeList) const
+    RouteJournal const & routeList) const
 {
-    auto routes = std::vector<std::shared_ptr<Types::Routing::Route>>{};
+    auto const & sourceSamplingPoint = samplingPointList_[sourceSamplingPointIndex];
+    auto const & targetSamplingPoint = samplingPointList_[targetSamplingPointIndex];
+    auto limitCandidates = [&](size_t const count) { return configuration_.maxCandidates == 0 ? count : std::min(count, configuration_.maxCandidates); };
+
+    size_t sourceCandidateBegin = 0;
+    size_t sourceCandidateCount = limitCandidates(sourceSamplingPoint.candidates.size());
+    std::optional<bool> sourceConsideredForwardsOptional;
+    if (auto previousConnectedRoute = findPreviousConnectedRoute(sourceSamplingPointIndex, routeList))
+    {
+        sourceCandidateBegin = (*previousConnectedRoute)->target.samplingPoint.candidate.index;
+        sourceCandidateCount = 1;
+        sourceConsideredForwardsOptional = (*previousConnectedRoute)->target.samplingPoint.candidate.consideredForwards;
+    }
+    size_t const targetCandidateCount = limitCandidates(targetSamplingPoint.candidates.size());
+
+    // Only the shortest route can be bounded from below, so only then the enumeration can stop before all candidate pairs are routed.
+    // This needs the pairs best-first, otherwise they are routed and clustered source candidate by source candidate, as they always were.
+    auto const stopEarly = configuration_.routeClusterPreference == RouteClusterPreference::shortest;
+    auto candidatePairs = CandidatePairEnumerator{sourceCandidateBegin, sourceCandidateCount, targetCandidateCount, stopEarly};
+    auto const remainingLengthLowerBounds = stopEarly
+        ? calcRemainingLengthLowerBounds(sourceSamplingPoint, sourceCandidateBegin, sourceCandidateCount, targetSamplingPoint, targetCandidateCount)
+        : std::vector<double>{};
 
-    auto selections = selectCandidates(sourceSamplingPointIndex, targetSamplingPointIndex, routeList, samplingPointList_);
+    // The clusters only live during this call, so their nodes are taken from a stack buffer (spilling to the heap for many candidates).
+    std::byte clusterBuffer[16 * 1024];
+    auto clusterResource = std::pmr::monotonic_buffer_resource{clusterBuffer, sizeof(clusterBuffer)};
+    auto clusteredRouteMatrix = ClusteredRouteMatrix{&clusterResource};
+    std::optional<size_t> lastDiagonal;
 
-    // TODO: comment the comments below in to use multi-threading; ATTENTION: DirectedCandidateRouter or LemonDigraph or Dijkstra are not yet reentrant, this has to be fixed before
-    //std::mutex mutex;
-    //std::vector<std::thread> threads;
-    for (auto const & selection : selections)
+    while (auto const candidatePair = candidatePairs.next())
     {
-        auto samplingPointsSelection = SamplingPointsSelection{{sourceSamplingPointIndex, selection.first}, {targetSamplingPointIndex, selection.second}};
-        if (visitedRouteSet.find(samplingPointsSelection) != visitedRouteSet.end())
-            continue;
-        //threads.emplace_back(
-        //    [&]() {
-        auto const route = routeCached(samplingPointsSelection, router_, routeMap);
-        //std::lock_guard<std::mutex> lock( mutex );
-        if (not route->subRoutes.empty())
-            routes.push_back(route);
-        routeMap.insert({samplingPointsSelection, route});
-        routingStatistic.calculated.insert({samplingPointsSelection, {route->cost(), route->length(), route->subRoutes.size()}});
-        //    } );
+        // The best route of a cluster is always its first route, so later routes can only win by founding a new cluster.
+        // Stop if no such route can be shorter than the current best route.
+        if (!remainingLengthLowerBounds.empty() && lastDiagonal != candidatePairs.diagonal())
+        {
+            lastDiagonal = candidatePairs.diagonal();
+            auto const bestRoute = getBestRoute(clusteredRouteMatrix, configuration_.routeClusterPreference);
+            if (bestRoute && bestRoute->length() < remainingLengthLowerBounds[candidatePairs.diagonal()])
+                break;
+        }
+
+        auto const [sourceCandidateIndex, targetCandidateIndex] = *candidatePair;
+        auto const consideredForwardsPairs = selectDirections(
+            sourceSamplingPoint.candidates.at(sourceCandidateIndex), targetSamplingPoint.candidates.at(targetCandidateIndex), sourceConsideredForwardsOptional);
+        for (auto const & [sourceConsideredForwards, targetConsideredForwards] : consideredForwardsPairs)
+        {
+            auto samplingPointsSelection = SamplingPointsSelection{
+                {sourceSamplingPointIndex, {sourceCandidateIndex, sourceConsideredForwards}}, {targetSamplingPointIndex, {targetCandidateIndex, targetConsideredForwards}}};
+            if (visitedRouteSet.find(samplingPointsSelection) != visitedRouteSet.end())
+                continue;
+            auto const route = routeCached(samplingPointsSelection, router_, routeMap);
+            if (not route->subRoutes.empty())
+                addToCluster(clusteredRouteMatrix, route, configuration_.maxClusteredRoutesLengthDifference, graphEdgeMap_);
+            routeMap.insert({samplingPointsSelection, route});
+            routingStatistic.calculated.insert({samplingPointsSelection, {route->cost(), route->length(), route->subRoutes.size()}});
+        }
     }
-    //for( auto & thread : threads )
-    //    thread.join();
 
-    return routes;
+    return getBestRoute(clusteredRouteMatrix, configuration_.routeClusterPreference);
 }
 
 std::shared_ptr<Types::Routing::Route> SamplingPointRouter::operator()(
     size_t const sourceSamplingPointIndex,
     size_t const targetSamplingPointIndex,
-    Types::Routing::RouteList const & routeList,
+    RouteJournal const & routeList,
     VisitedRouteSet & visitedRouteSet,
     RouteMap & routeMap,
     Types::Routing::RoutingStatistic & routingStatistic) const
 {
-    auto routes = calcPossibleRoutes(sourceSamplingPointIndex, targetSamplingPointIndex, visitedRouteSet, routeMap, routingStatistic, routeList);
-
-    auto clusteredRouteMatrix = cluster(routes, configuration_.maxClusteredRoutesLengthDifference, graphEdgeMap_);
-
-    auto route = getBestRoute(clusteredRouteMatrix, configuration_.routeClusterPreference);
+    auto route = calcBestRoute(sourceSamplingPointIndex, targetSamplingPointIndex, visitedRouteSet, routeMap, routingStatistic, routeList);
 
     if (!route)
     {
@@ -10,27 +10,30 @@
 
 #include <AppComponents/Common/Matcher/Routing/Comparators.h>
 #include <AppComponents/Common/Matcher/Routing/DirectedCandidateRouter.h>
+#include <AppComponents/Common/Matcher/Routing/RouteJournal.h>
 #include <AppComponents/Common/Matcher/Routing/Types.h>
 #include <AppComponents/Common/Types/Routing/Edge.h>
 #include <AppComponents/Common/Types/Routing/SamplingPoint.h>
 #include <AppComponents/Common/Types/Routing/Statistic.h>
 
+#include <Generic/Map/FlatHashMap.h>
+
 #include <functional>
 #include <memory>
-#include <unordered_map>
 
 namespace AppComponents::Common::Matcher::Routing {
 
 class SamplingPointRouter
 {
 public:
-    using VisitedRouteSet = std::unordered_set<SamplingPointsSelection>;
-    using RouteMap = std::unordered_map<SamplingPointsSelection, std::shared_ptr<Types::Routing::Route>>;
+    using VisitedRouteSet = ::Generic::FlatHashSet<SamplingPointsSelection>;
+    using RouteMap = ::Generic::FlatHashMap<SamplingPointsSelection, std::shared_ptr<Types::Routing::Route>>;
 
     struct Configuration
     {
         double maxClusteredRoutesLengthDifference;
         RouteClusterPreference routeClusterPreference;
+        size_t maxCandidates;  ///< Only the best candidates of each sampling point are routed, 0 to route all.
     };
 
     /**
@@ -48,19 +51,22 @@ public:
     std::shared_ptr<Types::Routing::Route> operator()(
         size_t sourceSamplingPointIndex,
         size_t targetSamplingPointIndex,
-        Types::Routing::RouteList const & routeList,
+        RouteJournal const & routeList,
         VisitedRouteSet & visitedRouteSet,
         RouteMap & routeMap,
         Types::Routing::RoutingStatistic & routingStatistic) const;
 
 private:
-    std::vector<std::shared_ptr<Types::Routing::Route>> calcPossibleRoutes(
+    /**
+     * Routes the candidate pairs, best-first if the shortest route is preferred, clusters the routes and returns the best route.
+     */
+    std::shared_ptr<Types::Routing::Route> calcBestRoute(
         size_t sourceSamplingPointIndex,
         size_t targetSamplingPointIndex,
         VisitedRouteSet & visitedRouteSet,
         RouteMap & routeMap,
         Types::Routing::RoutingStatistic & routingStatistic,
-        Types::Routing::RouteList const & routeList) const;
+        RouteJournal const & routeList) const;
 
     DirectedCandidateRouter const & router_;
     Configuration const configuration_;
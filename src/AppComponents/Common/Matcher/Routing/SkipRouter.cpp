@@ -17,7 +17,6 @@
 
 #include <mutex>
 #include <thread>
-#include <unordered_set>
 
 namespace AppComponents::Common::Matcher::Routing {
 
@@ -26,7 +25,7 @@ struct SkipRouter::Session
     explicit Session(
         size_t const sourceSamplingPointIndexStart_,
         size_t const targetSamplingPointIndexGoal_,
-        Types::Routing::RouteList & routeList_,
+        RouteJournal & routeList_,
         Types::Routing::RoutingStatistic & routingStatistic_)
       : sourceSamplingPointIndexStart(sourceSamplingPointIndexStart_), targetSamplingPointIndexGoal(targetSamplingPointIndexGoal_), routeList(routeList_),
         routingStatistic(routingStatistic_)
@@ -35,11 +34,11 @@ struct SkipRouter::Session
 
     size_t const sourceSamplingPointIndexStart;
     size_t const targetSamplingPointIndexGoal;
-    Types::Routing::RouteList & routeList;
+    RouteJournal & routeList;
     Types::Routing::RoutingStatistic & routingStatistic;
 
     SamplingPointRouter::RouteMap routeMap;
-    std::unordered_set<size_t> skippedSamplingPoints;
+    Generic::IndexSet skippedSamplingPoints;
 };
 
 std::tuple<RouteResult, size_t> SkipRouter::routeProcess(size_t const sourceSamplingPoint, Session & session) const
@@ -79,9 +78,6 @@ std::tuple<RouteResult, size_t> SkipRouter::skipProcess(size_t const sourceSampl
     // TODO: only for debugging
     auto getTime = [&](size_t const samplingPoint) { return Core::Common::Time::toString(timeList_[samplingPointList_[samplingPoint].trackIndex], "%H:%M:%S"); };
 
-    Generic::Skipper::CostFunction distanceFunction
-        = [&](size_t source, size_t target) { return calcApproximateDistanceBetweenSamplingPoints(source, target, samplingPointList_); };
-
     auto nextUnskippedSamplingPoint = Generic::findNextAllowed(sourceSamplingPoint, session.targetSamplingPointIndexGoal, session.skippedSamplingPoints);
     assert(nextUnskippedSamplingPoint);  // should find something, because if the goal would not be reachable, skipProcess would not have been called
 
@@ -91,12 +87,13 @@ std::tuple<RouteResult, size_t> SkipRouter::skipProcess(size_t const sourceSampl
         session.sourceSamplingPointIndexStart,
         session.targetSamplingPointIndexGoal,
         session.skippedSamplingPoints,
-        distanceFunction,
+        samplingPointLocationList_,
         configuration_.maxBacktrackingDistance,
         configuration_.skipStrategy};
 
-    auto const routeListSnapshot = session.routeList;
-    auto const alreadySkippedSampingPoints = session.skippedSamplingPoints;
+    auto checkpoint = RouteJournal::Checkpoint{session.routeList};
+    // The selected skipper may change between trials, so its skipped sampling points are added anew to the ones skipped before.
+    auto skippedCheckpoint = Generic::IndexSet::Checkpoint{session.skippedSamplingPoints};
 
     while (skipper.next())
     {
@@ -104,8 +101,9 @@ std::tuple<RouteResult, size_t> SkipRouter::skipProcess(size_t const sourceSampl
 
         auto const routeSource = attachToPreviousRoute(session.routeList, skipper.source());
 
-        session.skippedSamplingPoints = alreadySkippedSampingPoints;
-        session.skippedSamplingPoints.merge(skipper.skipped());
+        skippedCheckpoint.rollback();
+        for (auto const samplingPoint : skipper.skipped())
+            session.skippedSamplingPoints.insert(samplingPoint);
         auto const [result, reached] = routeProcess(routeSource, session);
 
         if (result != RouteResult::goalNotReachedButReachable)
@@ -122,15 +120,15 @@ std::tuple<RouteResult, size_t> SkipRouter::skipProcess(size_t const sourceSampl
         APP_LOG(debug) << "skipping not successful, farthest " << getTime(sourceSamplingPoint) << ", last skip " << getTime(skipper.source()) << ".." << getTime(skipper.target());
     else
         APP_LOG(debug) << "skipping not successful, farthest " << getTime(sourceSamplingPoint) << ", last skip none";
-    session.routeList = routeListSnapshot;
-    session.skippedSamplingPoints = alreadySkippedSampingPoints;
+    checkpoint.rollback();
+    skippedCheckpoint.rollback();
     return {RouteResult::goalNotReachedButReachable, sourceSamplingPoint};
 }
 
 void SkipRouter::operator()(
     size_t const sourceSamplingPointIndexStart,
     size_t const targetSamplingPointIndexGoal,
-    Types::Routing::RouteList & routeList,
+    RouteJournal & routeList,
     Types::Routing::RoutingStatistic & routingStatistic) const
 {
     APP_LOG_LOCATION("SkipRouter");
@@ -31,21 +31,26 @@ public:
     };
 
     SkipRouter(
-        BacktrackRouter const & router, Configuration const configuration, Types::Routing::SamplingPointList const & samplingPointList, Types::Track::TimeList const & timeList)
-      : router_(router), configuration_(configuration), samplingPointList_(samplingPointList), timeList_(timeList)
+        BacktrackRouter const & router,
+        Configuration const configuration,
+        Types::Routing::SamplingPointList const & samplingPointList,
+        Types::Routing::SamplingPointLocationList const & samplingPointLocationList,
+        Types::Track::TimeList const & timeList)
+      : router_(router), configuration_(configuration), samplingPointList_(samplingPointList), samplingPointLocationList_(samplingPointLocationList), timeList_(timeList)
     {
     }
 
     void operator()(
         size_t sourceSamplingPointIndexStart,
         size_t targetSamplingPointIndexGoal,
-        Types::Routing::RouteList & routeList,
+        RouteJournal & routeList,
         Types::Routing::RoutingStatistic & routingStatistic) const;
 
 private:
     BacktrackRouter const & router_;
     Configuration const configuration_;
     Types::Routing::SamplingPointList const & samplingPointList_;
+    Types::Routing::SamplingPointLocationList const & samplingPointLocationList_;
     Types::Track::TimeList const & timeList_;  // TODO: only for debugging
 
     /**
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Matcher/Routing/Helper.h>
+#include <AppComponents/Common/Matcher/Routing/StreetLengthRouting.h>
+
+#include <utility>
+
+namespace AppComponents::Common::Matcher::Routing {
+
+namespace {
+
+    Types::Street::SegmentLengthList calcSegmentLengths(Types::Street::SegmentList const & segmentList)
+    {
+        auto segmentLengthList = Types::Street::SegmentLengthList{};
+        segmentLengthList.reserve(segmentList.size());
+        for (auto const & segment : segmentList)
+            segmentLengthList.push_back(geoDistance(segment.geometry));
+        return segmentLengthList;
+    }
+
+}  // namespace
+
+StreetLengthRouting::StreetLengthRouting(
+    DirectedCandidateRouter::Configuration const configuration,
+    Types::Routing::SamplingPointList const & samplingPointList,
+    Types::Graph::Graph const & graph,
+    Types::Graph::GraphEdgeMap const & graphEdgeMap,
+    Types::Graph::StreetIndexMap const & streetIndexMap,
+    Types::Track::TimeList const & timeList,
+    Types::Track::VelocityList const & velocityList,
+    Types::Street::SegmentList const & segmentList,
+    std::shared_ptr<PathCache> pathCache,
+    std::shared_ptr<Types::Routing::Arena> arena)
+  : segmentLengthList_(calcSegmentLengths(segmentList)), algorithm_(graph), pathCache_(pathCache ? std::move(pathCache) : std::make_shared<PathCache>()),
+    initialPathCacheHits_(pathCache_->hits()), initialPathCacheMisses_(pathCache_->misses()),
+    router_(
+        algorithm_,
+        graph,
+        *pathCache_,
+        PathCache::CostProfile::geoDistance,
+        configuration,
+        samplingPointList,
+        graphEdgeMap,
+        streetIndexMap,
+        timeList,
+        velocityList,
+        segmentList,
+        segmentLengthList_,
+        std::move(arena))
+{
+    algorithm_.setCost([this, &graphEdgeMap](Core::Graph::Edge edge) { return segmentLengthList_.at(graphEdgeMap.at(edge).streetIndex); });
+}
+
+}  // namespace AppComponents::Common::Matcher::Routing
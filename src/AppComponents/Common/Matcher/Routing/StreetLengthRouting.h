@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <AppComponents/Common/Matcher/Routing/DirectedCandidateRouter.h>
+#include <AppComponents/Common/Matcher/Routing/PathCache.h>
+#include <AppComponents/Common/Types/Graph/EdgeMap.h>
+#include <AppComponents/Common/Types/Graph/Graph.h>
+#include <AppComponents/Common/Types/Routing/Arena.h>
+#include <AppComponents/Common/Types/Routing/SamplingPoint.h>
+#include <AppComponents/Common/Types/Street/Segment.h>
+#include <AppComponents/Common/Types/Track/Time.h>
+#include <AppComponents/Common/Types/Track/Velocity.h>
+
+#include <Core/Graph/Routing/Dijkstra.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace AppComponents::Common::Matcher::Routing {
+
+/**
+ * Sets up a `DirectedCandidateRouter` which routes by street length, as shared by the routers:
+ * the segment lengths, the Dijkstra algorithm with its cost function and the path cache.
+ */
+class StreetLengthRouting
+{
+public:
+    /// @param pathCache Used for the paths, a new cache is used if `nullptr`.
+    StreetLengthRouting(
+        DirectedCandidateRouter::Configuration const configuration,
+        Types::Routing::SamplingPointList const & samplingPointList,
+        Types::Graph::Graph const & graph,
+        Types::Graph::GraphEdgeMap const & graphEdgeMap,
+        Types::Graph::StreetIndexMap const & streetIndexMap,
+        Types::Track::TimeList const & timeList,
+        Types::Track::VelocityList const & velocityList,
+        Types::Street::SegmentList const & segmentList,
+        std::shared_ptr<PathCache> pathCache,
+        std::shared_ptr<Types::Routing::Arena> arena);
+
+    // The router references the members.
+    StreetLengthRouting(StreetLengthRouting const &) = delete;
+    StreetLengthRouting & operator=(StreetLengthRouting const &) = delete;
+
+    DirectedCandidateRouter const & router() const { return router_; }
+
+    /// @return The path cache hits since construction.
+    size_t pathCacheHits() const { return pathCache_->hits() - initialPathCacheHits_; }
+
+    /// @return The path cache misses since construction.
+    size_t pathCacheMisses() const { return pathCache_->misses() - initialPathCacheMisses_; }
+
+private:
+    Types::Street::SegmentLengthList const segmentLengthList_;
+    Core::Graph::Routing::Dijkstra algorithm_;
+    std::shared_ptr<PathCache> const pathCache_;
+    size_t const initialPathCacheHits_;
+    size_t const initialPathCacheMisses_;
+    DirectedCandidateRouter const router_;
+};
+
+}  // namespace AppComponents::Common::Matcher::Routing
@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Matcher/Routing/Helper.h>
+#include <AppComponents/Common/Matcher/Routing/ViterbiLattice.h>
+
+#include <amblog/global.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace AppComponents::Common::Matcher::Routing {
+
+bool ViterbiLattice::operator()(Types::Routing::RouteList & routeList, Types::Routing::RoutingStatistic & routingStatistic) const
+{
+    APP_LOG_LOCATION("ViterbiLattice");
+
+    auto layers = std::vector<Layer>{};
+    for (size_t samplingPointIndex = 0; samplingPointIndex < samplingPointList_.size(); ++samplingPointIndex)
+    {
+        auto layer = makeLayer(samplingPointIndex);
+        if (layer.empty())
+        {
+            flush(layers, routeList, routingStatistic);
+            continue;
+        }
+
+        if (!layers.empty() && !connect(layers.back(), layer, routingStatistic))
+        {
+            routingStatistic.visited.emplace_back(SamplingPointsSelection{{samplingPointIndex - 1, {0, true}}, {samplingPointIndex, {0, true}}}, false);
+            flush(layers, routeList, routingStatistic);
+        }
+
+        if (layers.empty())
+            restart(layer);
+        layers.push_back(std::move(layer));
+    }
+    flush(layers, routeList, routingStatistic);
+
+    APP_LOG(noise) << routeList.size() << " edges routed";
+
+    return true;
+}
+
+ViterbiLattice::Layer ViterbiLattice::makeLayer(size_t const samplingPointIndex) const
+{
+    auto const & candidates = samplingPointList_[samplingPointIndex].candidates;
+    auto const candidateCount = configuration_.maxCandidates == 0 ? candidates.size() : std::min(candidates.size(), configuration_.maxCandidates);
+
+    auto layer = Layer{};
+    layer.reserve(2 * candidateCount);
+    for (size_t candidateIndex = 0; candidateIndex < candidateCount; ++candidateIndex)
+    {
+        auto const & candidate = candidates[candidateIndex];
+        auto const distance = candidate.streetSegmentDistance / configuration_.measurementNoise;
+        auto const headingDifference = candidate.streetSegmentHeadingDifference / configuration_.headingNoise;
+        auto const emissionCost = 0.5 * (distance * distance + headingDifference * headingDifference);
+
+        auto addState = [&](bool const consideredForwards)
+        { layer.push_back(State{{samplingPointIndex, {candidateIndex, consideredForwards}}, emissionCost, std::numeric_limits<double>::infinity(), std::nullopt, nullptr}); };
+        if (candidate.streetSegmentTravelDirection != Types::Street::TravelDirection::backwards)
+            addState(true);
+        if (candidate.streetSegmentTravelDirection != Types::Street::TravelDirection::forwards)
+            addState(false);
+    }
+    return layer;
+}
+
+void ViterbiLattice::restart(Layer & layer)
+{
+    for (auto & state : layer)
+    {
+        state.cost = state.emissionCost;
+        state.previous = std::nullopt;
+        state.route = nullptr;
+    }
+}
+
+bool ViterbiLattice::connect(Layer const & sourceLayer, Layer & targetLayer, Types::Routing::RoutingStatistic & routingStatistic) const
+{
+    auto const sourceSamplingPointIndex = sourceLayer.front().selection.index;
+    auto const targetSamplingPointIndex = targetLayer.front().selection.index;
+    auto const samplingPointDistance = calcApproximateDistanceBetweenSamplingPoints(sourceSamplingPointIndex, targetSamplingPointIndex, samplingPointList_);
+
+    auto samplingPointsSelections = std::vector<SamplingPointsSelection>{};
+    samplingPointsSelections.reserve(sourceLayer.size() * targetLayer.size());
+    for (auto const & sourceState : sourceLayer)
+        for (auto const & targetState : targetLayer)
+            samplingPointsSelections.push_back({sourceState.selection, targetState.selection});
+
+    // All paths of this step are searched up front, one search per distinct source node.
+    router_.prefetchPaths(samplingPointsSelections);
+
+    bool reached = false;
+    for (size_t sourceStateIndex = 0; sourceStateIndex < sourceLayer.size(); ++sourceStateIndex)
+    {
+        auto const & sourceState = sourceLayer[sourceStateIndex];
+        for (auto & targetState : targetLayer)
+        {
+            auto const samplingPointsSelection = SamplingPointsSelection{sourceState.selection, targetState.selection};
+            auto const route = router_(samplingPointsSelection);
+            routingStatistic.calculated.insert({samplingPointsSelection, {route->cost(), route->length(), route->subRoutes.size()}});
+            if (route->subRoutes.empty())
+                continue;
+
+            auto const transitionCost = std::abs(route->length() - samplingPointDistance) / configuration_.transitionScale;
+            auto const cost = sourceState.cost + transitionCost + targetState.emissionCost;
+            if (cost < targetState.cost)
+            {
+                targetState.cost = cost;
+                targetState.previous = sourceStateIndex;
+                targetState.route = route;
+                reached = true;
+            }
+        }
+    }
+    // Unreachable states cannot be part of the best path.
+    if (reached)
+        targetLayer.erase(std::remove_if(targetLayer.begin(), targetLayer.end(), [](State const & state) { return !state.previous; }), targetLayer.end());
+    return reached;
+}
+
+void ViterbiLattice::flush(std::vector<Layer> & layers, Types::Routing::RouteList & routeList, Types::Routing::RoutingStatistic & routingStatistic) const
+{
+    if (layers.size() > 1)
+    {
+        auto const & lastLayer = layers.back();
+        auto stateIndex = static_cast<size_t>(
+            std::min_element(lastLayer.begin(), lastLayer.end(), [](State const & a, State const & b) { return a.cost < b.cost; }) - lastLayer.begin());
+
+        auto routes = Types::Routing::RouteList{};
+        routes.reserve(layers.size() - 1);
+        for (auto layerIt = layers.rbegin(); std::next(layerIt) != layers.rend(); ++layerIt)
+        {
+            auto const & state = (*layerIt)[stateIndex];
+            routes.push_back(state.route);
+            stateIndex = *state.previous;
+        }
+
+        for (auto routeIt = routes.rbegin(); routeIt != routes.rend(); ++routeIt)
+        {
+            routingStatistic.visited.emplace_back(SamplingPointsSelection{(*routeIt)->source.samplingPoint, (*routeIt)->target.samplingPoint}, true);
+            routeList.push_back(*routeIt);
+        }
+    }
+    layers.clear();
+}
+
+}  // namespace AppComponents::Common::Matcher::Routing
@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <AppComponents/Common/Matcher/Routing/DirectedCandidateRouter.h>
+#include <AppComponents/Common/Types/Routing/Edge.h>
+#include <AppComponents/Common/Types/Routing/SamplingPoint.h>
+#include <AppComponents/Common/Types/Routing/Statistic.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace AppComponents::Common::Matcher::Routing {
+
+/**
+ * Matches the sampling points with a hidden Markov model, solved by the Viterbi algorithm.
+ *
+ * The hidden states of a sampling point are its directed candidates.
+ * The emission cost of a state is the negative log-likelihood of its distance and heading difference to the track point,
+ * the transition cost between two states is the negative log-likelihood of the difference between the route length and the distance of the sampling points.
+ * All costs are given without their constant terms.
+ *
+ * Each step routes all state pairs of two consecutive sampling points, so the runtime is bounded by O(n·k²) routes for n sampling points and k states.
+ * If no state of a sampling point can be reached, the lattice is split into pieces which are matched independently (like the `PiecewiseRouter` does).
+ */
+class ViterbiLattice
+{
+public:
+    struct Configuration
+    {
+        double measurementNoise;  ///< Standard deviation of the track point positions in meters.
+        double headingNoise;  ///< Standard deviation of the track point headings in degrees.
+        double transitionScale;  ///< Expected difference between the route length and the sampling point distance in meters.
+        size_t maxCandidates;  ///< Only the best candidates of each sampling point become states, 0 to use all.
+    };
+
+    ViterbiLattice(DirectedCandidateRouter const & router, Configuration const configuration, Types::Routing::SamplingPointList const & samplingPointList)
+      : router_(router), configuration_(configuration), samplingPointList_(samplingPointList)
+    {
+    }
+
+    bool operator()(Types::Routing::RouteList & routeList, Types::Routing::RoutingStatistic & routingStatistic) const;
+
+    // The building blocks of the lattice, also used to match the sampling points incrementally.
+
+    struct State
+    {
+        Types::Routing::SamplingPointSelection selection;
+        double emissionCost;
+        double cost;  ///< Cost of the best path through the lattice ending in this state.
+        std::optional<size_t> previous;  ///< Index of the predecessor state on the best path, if any.
+        std::shared_ptr<Types::Routing::Route> route;  ///< Route from the predecessor state.
+    };
+    using Layer = std::vector<State>;
+
+    Layer makeLayer(size_t samplingPointIndex) const;
+
+    /**
+     * Makes the layer the first one of a piece, only its emission costs count.
+     */
+    static void restart(Layer & layer);
+
+    /**
+     * Routes all state pairs of two consecutive layers and keeps the best predecessor of each target state.
+     * Unreachable target states are removed, unless no target state is reachable at all.
+     * @return Whether any target state was reached.
+     */
+    bool connect(Layer const & sourceLayer, Layer & targetLayer, Types::Routing::RoutingStatistic & routingStatistic) const;
+
+private:
+    /**
+     * Appends the routes of the best path through the layers and clears the layers.
+     */
+    void flush(std::vector<Layer> & layers, Types::Routing::RouteList & routeList, Types::Routing::RoutingStatistic & routingStatistic) const;
+
+    DirectedCandidateRouter const & router_;
+    Configuration const configuration_;
+    Types::Routing::SamplingPointList const & samplingPointList_;
+};
+
+}  // namespace AppComponents::Common::Matcher::Routing
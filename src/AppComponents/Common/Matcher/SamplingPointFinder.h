@@ -22,6 +22,7 @@ class SamplingPointFinder : public ambpipeline::Filter
 {
 public:
     enum class SelectionStrategy { all, best, singles };
+    /// @param segmentGeometryList Read instead of the geometries of \p segmentList if given, see `CandidateFinder`.
     SamplingPointFinder(
         SelectionStrategy selectionStrategy,
         double searchRadius,
@@ -29,7 +30,8 @@ public:
         Types::Track::PointList const & pointList,
         Types::Track::HeadingList const & headingList,
         Types::Street::SegmentList const & segmentList,
-        Types::Street::TravelDirectionList const & travelDirectionList);
+        Types::Street::TravelDirectionList const & travelDirectionList,
+        Types::Street::SegmentGeometryList const * segmentGeometryList = nullptr);
     bool operator()( Types::Routing::SamplingPointList & );
 
 private:
@@ -40,6 +42,7 @@ private:
     Types::Street::SegmentList const & segmentList_;
     Types::Street::TravelDirectionList const & travelDirectionList_;
     Types::Track::HeadingList const & headingList_;
+    Types::Street::SegmentGeometryList const * const segmentGeometryList_;
 };
 
 }  // namespace AppComponents::Common::Matcher
@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Matcher/Routing/Helper.h>
+#include <AppComponents/Common/Matcher/Routing/StreetLengthRouting.h>
+#include <AppComponents/Common/Matcher/Routing/ViterbiLattice.h>
+#include <AppComponents/Common/Matcher/ViterbiRouter.h>
+
+#include <amblog/global.h>
+
+#include <utility>
+
+namespace AppComponents::Common::Matcher {
+
+ViterbiRouter::ViterbiRouter(
+    double const maxVelocityDifference,
+    bool const allowSelfIntersection,
+    double const maxAngularDeviation,
+    double const accountTurningCircleLength,
+    double const measurementNoise,
+    double const headingNoise,
+    double const transitionScale,
+    size_t const maxCandidatesPerSamplingPoint,
+    Types::Track::TimeList const & timeList,
+    Types::Track::VelocityList const & velocityList,
+    Types::Street::SegmentList const & segmentList,
+    std::shared_ptr<Routing::PathCache> pathCache)
+  : Filter("ViterbiRouter"), maxVelocityDifference_(maxVelocityDifference), allowSelfIntersection_(allowSelfIntersection), maxAngularDeviation_(maxAngularDeviation),
+    accountTurningCircleLength_(accountTurningCircleLength), measurementNoise_(measurementNoise), headingNoise_(headingNoise), transitionScale_(transitionScale),
+    maxCandidatesPerSamplingPoint_(maxCandidatesPerSamplingPoint), timeList_(timeList), velocityList_(velocityList), segmentList_(segmentList), pathCache_(std::move(pathCache))
+{
+    setRequirements({"SamplingPointList", "Graph", "GraphEdgeMap", "StreetIndexMap"});
+    setOptionals({});
+    setFulfillments({"RouteList", "RoutingStatistic"});
+}
+
+bool ViterbiRouter::operator()(
+    Types::Routing::SamplingPointList const & samplingPointList,
+    Types::Graph::Graph const & graph,
+    Types::Graph::GraphEdgeMap const & graphEdgeMap,
+    Types::Graph::StreetIndexMap const & streetIndexMap,
+    Types::Routing::RouteList & routeList,
+    Types::Routing::RoutingStatistic & routingStatistic)
+{
+    auto const streetLengthRouting = Routing::StreetLengthRouting{
+        {maxVelocityDifference_, allowSelfIntersection_, maxAngularDeviation_, accountTurningCircleLength_},
+        samplingPointList,
+        graph,
+        graphEdgeMap,
+        streetIndexMap,
+        timeList_,
+        velocityList_,
+        segmentList_,
+        pathCache_,
+        Types::Routing::makeArena()};
+    auto const & directedCandidateRouter = streetLengthRouting.router();
+
+    auto viterbiLattice
+        = Routing::ViterbiLattice{directedCandidateRouter, {measurementNoise_, headingNoise_, transitionScale_, maxCandidatesPerSamplingPoint_}, samplingPointList};
+
+    viterbiLattice(routeList, routingStatistic);
+    Routing::copyToHeap(routeList);
+
+    APP_LOG(noise) << "path cache: " << streetLengthRouting.pathCacheHits() << " hits, " << streetLengthRouting.pathCacheMisses() << " misses";
+
+    return true;
+}
+
+}  // namespace AppComponents::Common::Matcher
@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <AppComponents/Common/Matcher/Routing/PathCache.h>
+#include <AppComponents/Common/Types/Graph/EdgeMap.h>
+#include <AppComponents/Common/Types/Graph/Graph.h>
+#include <AppComponents/Common/Types/Routing/Edge.h>
+#include <AppComponents/Common/Types/Routing/SamplingPoint.h>
+#include <AppComponents/Common/Types/Routing/Statistic.h>
+#include <AppComponents/Common/Types/Street/Segment.h>
+#include <AppComponents/Common/Types/Track/Time.h>
+#include <AppComponents/Common/Types/Track/Velocity.h>
+
+#include <ambpipeline/Filter.h>
+
+#include <memory>
+
+namespace AppComponents::Common::Matcher {
+
+/**
+ * Alternative to the `Router` with a bounded runtime, matching the sampling points with a hidden Markov model.
+ */
+class ViterbiRouter : public ambpipeline::Filter
+{
+public:
+    ViterbiRouter(
+        double maxVelocityDifference,
+        bool allowSelfIntersection,
+        double maxAngularDeviation,
+        double accountTurningCircleLength,
+        double measurementNoise,
+        double headingNoise,
+        double transitionScale,
+        size_t maxCandidatesPerSamplingPoint,
+        Types::Track::TimeList const & timeList,
+        Types::Track::VelocityList const & velocityList,
+        Types::Street::SegmentList const & segmentList,
+        std::shared_ptr<Routing::PathCache> pathCache = nullptr);
+    bool operator()(
+        Types::Routing::SamplingPointList const &,
+        Types::Graph::Graph const &,
+        Types::Graph::GraphEdgeMap const &,
+        Types::Graph::StreetIndexMap const &,
+        Types::Routing::RouteList &,
+        Types::Routing::RoutingStatistic &);
+
+private:
+    double const maxVelocityDifference_;
+    bool const allowSelfIntersection_;
+    double const maxAngularDeviation_;
+    double const accountTurningCircleLength_;
+    double const measurementNoise_;
+    double const headingNoise_;
+    double const transitionScale_;
+    size_t const maxCandidatesPerSamplingPoint_;
+    Types::Track::TimeList const & timeList_;
+    Types::Track::VelocityList const & velocityList_;
+    Types::Street::SegmentList const & segmentList_;
+    std::shared_ptr<Routing::PathCache> const pathCache_;  ///< Shared between runs if given, else a new cache is used per run.
+};
+
+}  // namespace AppComponents::Common::Matcher
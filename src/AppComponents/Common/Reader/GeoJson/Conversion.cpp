@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Reader/GeoJson/Conversion.h>
+
+#include <Core/Common/Geometry/Conversion.h>
+
+#include <stdexcept>
+
+namespace AppComponents::Common::Reader::GeoJson {
+
+Types::Street::TravelDirection toTravelDirection(std::string const & text)
+{
+    if (text == "Both")
+        return Types::Street::TravelDirection::both;
+    if (text == "Forwards")
+        return Types::Street::TravelDirection::forwards;
+    if (text == "Backwards")
+        return Types::Street::TravelDirection::backwards;
+    throw std::domain_error("TravelDirection '" + text + "' unknown");
+}
+
+Types::Street::Highway toHighway(std::string const & text)
+{
+    using Types::Street::HighwayType;
+    if (text == "Motorway")
+        return HighwayType::motorway;
+    if (text == "Trunk")
+        return HighwayType::trunk;
+    if (text == "Primary")
+        return HighwayType::primary;
+    if (text == "Secondary")
+        return HighwayType::secondary;
+    if (text == "Tertiary")
+        return HighwayType::tertiary;
+    if (text == "MotorwayLink")
+        return HighwayType::motorway_link;
+    if (text == "TrunkLink")
+        return HighwayType::trunk_link;
+    if (text == "PrimaryLink")
+        return HighwayType::primary_link;
+    if (text == "SecondaryLink")
+        return HighwayType::secondary_link;
+    if (text == "TertiaryLink")
+        return HighwayType::tertiary_link;
+    if (text == "Unknown")
+        return std::nullopt;
+    throw std::domain_error("Highway '" + text + "' unknown");
+}
+
+Feature toFeature(nlohmann::json const & feature)
+{
+    if (feature.at("type").get_ref<std::string const &>() != "Feature")
+        throw std::domain_error("'type' of FeatureCollection item has to be 'Feature' but is '" + feature.at("type").get<std::string>() + '\'');
+
+    auto const & properties = feature.at("properties");
+
+    return {
+        {properties.at("Id").get<size_t>(), properties.at("Offset").get<size_t>(), Core::Common::Geometry::toLineString(feature.at("geometry"))},
+        {properties.at("SourceNode").get<size_t>(), properties.at("TargetNode").get<size_t>()},
+        toTravelDirection(properties.at("TravelDirection").get_ref<std::string const &>()),
+        toHighway(properties.at("Highway").get_ref<std::string const &>())};
+}
+
+}  // namespace AppComponents::Common::Reader::GeoJson
@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <AppComponents/Common/Types/Street/Highway.h>
+#include <AppComponents/Common/Types/Street/NodePair.h>
+#include <AppComponents/Common/Types/Street/Segment.h>
+#include <AppComponents/Common/Types/Street/TravelDirection.h>
+
+#include <nlohmann/json.hpp>
+
+#include <string>
+
+namespace AppComponents::Common::Reader::GeoJson {
+
+/// A street segment with its properties, as stored in one GeoJSON feature.
+struct Feature
+{
+    Types::Street::Segment segment;
+    Types::Street::NodePair nodePair;
+    Types::Street::TravelDirection travelDirection;
+    Types::Street::Highway highway;
+};
+
+/// @throws std::domain_error If the text is no travel direction.
+Types::Street::TravelDirection toTravelDirection(std::string const & text);
+
+/// @throws std::domain_error If the text is no highway type.
+Types::Street::Highway toHighway(std::string const & text);
+
+/// @throws std::domain_error If the feature is no `Feature` with a `LineString` geometry, nlohmann::json::exception if properties are missing.
+Feature toFeature(nlohmann::json const & feature);
+
+}  // namespace AppComponents::Common::Reader::GeoJson
@@ -6,58 +6,15 @@
 
 #include <AppComponents/Common/Reader/GeoJsonMapReader.h>
 
-#include <Core/Common/Geometry/Conversion.h>
-#include <Core/Common/Geometry/Helper.h>
+#include <AppComponents/Common/Reader/GeoJson/Conversion.h>
 
 #include <amblog/global.h>
 #include <nlohmann/json.hpp>
 
-namespace AppComponents::Common::Reader {
-
-namespace {
-
-    Types::Street::TravelDirection toTravelDirection(std::string const & text)
-    {
-        if (text == "Both")
-            return Types::Street::TravelDirection::both;
-        if (text == "Forwards")
-            return Types::Street::TravelDirection::forwards;
-        if (text == "Backwards")
-            return Types::Street::TravelDirection::backwards;
-        APP_LOG(error) << "TravelDirection '" << text << "' unknown";
-        APP_THROW_LOGGED_EXCEPTION();
-    }
+#include <stdexcept>
+#include <utility>
 
-    Types::Street::Highway toHighway(std::string const & text)
-    {
-        using Types::Street::HighwayType;
-        if (text == "Motorway")
-            return HighwayType::motorway;
-        if (text == "Trunk")
-            return HighwayType::trunk;
-        if (text == "Primary")
-            return HighwayType::primary;
-        if (text == "Secondary")
-            return HighwayType::secondary;
-        if (text == "Tertiary")
-            return HighwayType::tertiary;
-        if (text == "MotorwayLink")
-            return HighwayType::motorway_link;
-        if (text == "TrunkLink")
-            return HighwayType::trunk_link;
-        if (text == "PrimaryLink")
-            return HighwayType::primary_link;
-        if (text == "SecondaryLink")
-            return HighwayType::secondary_link;
-        if (text == "TertiaryLink")
-            return HighwayType::tertiary_link;
-        if (text == "Unknown")
-            return std::nullopt;
-        APP_LOG(error) << "Highway '" << text << "' unknown";
-        APP_THROW_LOGGED_EXCEPTION();
-    }
-
-}  // namespace
+namespace AppComponents::Common::Reader {
 
 GeoJsonMapReader::GeoJsonMapReader(std::istream & input) : input_(input)
 {
@@ -81,20 +38,25 @@ bool GeoJsonMapReader::operator()(
     }
 
     nlohmann::json & features = json.at("features");
+    segmentList.reserve(segmentList.size() + features.size());
+    nodePairList.reserve(nodePairList.size() + features.size());
+    travelDirectionList.reserve(travelDirectionList.size() + features.size());
+    highwayList.reserve(highwayList.size() + features.size());
     for (auto const & feature : features)
     {
-        if (feature.at("type").get<std::string>() != "Feature")
+        try
         {
-            APP_LOG(error) << "'type' of FeatureCollection item has to be 'Feature' but is '" << feature.at("type").get<std::string>() << '\'';
+            auto converted = GeoJson::toFeature(feature);
+            segmentList.push_back(std::move(converted.segment));
+            nodePairList.push_back(converted.nodePair);
+            travelDirectionList.push_back(converted.travelDirection);
+            highwayList.push_back(converted.highway);
+        }
+        catch (std::domain_error const & error)
+        {
+            APP_LOG(error) << error.what();
             APP_THROW_LOGGED_EXCEPTION();
         }
-
-        auto const & properties = feature.at("properties");
-
-        segmentList.push_back({properties.at("Id").get<size_t>(), properties.at("Offset").get<size_t>(), Core::Common::Geometry::toLineString(feature.at("geometry"))});
-        nodePairList.push_back({properties.at("SourceNode").get<size_t>(), properties.at("TargetNode").get<size_t>()});
-        travelDirectionList.push_back(toTravelDirection(properties.at("TravelDirection").get<std::string>()));
-        highwayList.push_back(toHighway(properties.at("Highway").get<std::string>()));
     }
 
     APP_LOG_MS(noise) << segmentList.size() << " street segments created";
@@ -11,8 +11,166 @@
 #include <amblog/global.h>
 #include <nlohmann/json.hpp>
 
+#include <cmath>
+#include <optional>
+#include <string>
+#include <utility>
+
 namespace AppComponents::Common::Reader {
 
+namespace {
+
+    /**
+     * Collects the track points of a JSON array of objects while they are parsed, so the document is never held in memory.
+     */
+    class TrackSaxHandler : public nlohmann::json_sax<nlohmann::json>
+    {
+    public:
+        TrackSaxHandler(
+            Types::Track::TimeList & timeList, Types::Track::PointList & pointList, Types::Track::HeadingList & headingList, Types::Track::VelocityList & velocityList)
+          : timeList_(timeList), pointList_(pointList), headingList_(headingList), velocityList_(velocityList)
+        {
+        }
+
+        /// Set if parsing was stopped, either because of invalid JSON or an invalid track point.
+        std::string const & error() const { return error_; }
+
+        bool null() override { return value(std::nullopt); }
+        bool boolean(bool) override { return value(std::nullopt); }
+        bool number_integer(number_integer_t const number) override { return value(static_cast<double>(number)); }
+        bool number_unsigned(number_unsigned_t const number) override { return value(static_cast<double>(number)); }
+        bool number_float(number_float_t const number, string_t const &) override { return value(static_cast<double>(number)); }
+        bool binary(binary_t &) override { return value(std::nullopt); }
+
+        bool string(string_t & text) override
+        {
+            if (depth_ == pointDepth && key_ == "pos_time")
+            {
+                point_.time = std::move(text);
+                return true;
+            }
+            return value(std::nullopt);
+        }
+
+        bool start_object(size_t) override
+        {
+            if (depth_ == 0)
+                return fail("Track is not an array");
+            if (depth_ == pointDepth - 1)
+                point_ = {};
+            else if (depth_ == pointDepth && !value(std::nullopt))
+                return false;
+            ++depth_;
+            return true;
+        }
+
+        bool key(string_t & key) override
+        {
+            if (depth_ == pointDepth)
+                key_ = std::move(key);
+            return true;
+        }
+
+        bool end_object() override
+        {
+            --depth_;
+            return depth_ == pointDepth - 1 ? addPoint() : true;
+        }
+
+        bool start_array(size_t) override
+        {
+            if (depth_ == pointDepth - 1)
+                return fail("Track point is not an object");
+            if (depth_ == pointDepth && !value(std::nullopt))
+                return false;
+            ++depth_;
+            return true;
+        }
+
+        bool end_array() override
+        {
+            --depth_;
+            return true;
+        }
+
+        bool parse_error(size_t, std::string const &, nlohmann::detail::exception const & exception) override { return fail(exception.what()); }
+
+    private:
+        // The track is an array of track point objects.
+        static constexpr size_t pointDepth = 2;
+
+        struct Point
+        {
+            std::optional<std::string> time;
+            std::optional<double> latitude;
+            std::optional<double> longitude;
+            std::optional<double> course;
+            std::optional<double> speed;
+        };
+
+        bool fail(std::string error)
+        {
+            error_ = std::move(error);
+            return false;
+        }
+
+        /// Handles a value, `number` is empty if it is no number. Values of nested objects and arrays are skipped.
+        bool value(std::optional<double> const number)
+        {
+            if (depth_ == 0)
+                return fail("Track is not an array");
+            if (depth_ == pointDepth - 1)
+                return fail("Track point is not an object");
+            if (depth_ > pointDepth)
+                return true;
+
+            auto field = [&]() -> std::optional<double> *
+            {
+                if (key_ == "latitude")
+                    return &point_.latitude;
+                if (key_ == "longitude")
+                    return &point_.longitude;
+                if (key_ == "course")
+                    return &point_.course;
+                if (key_ == "speed")
+                    return &point_.speed;
+                return nullptr;
+            }();
+            if (key_ == "pos_time" || (field && !number))
+                return fail("Invalid type of " + key_);
+            if (field)
+                *field = number;
+            return true;
+        }
+
+        bool addPoint()
+        {
+            if (!point_.time || !point_.latitude || !point_.longitude || !point_.speed)
+                return fail("Track point lacks one of pos_time, latitude, longitude or speed");
+
+            auto [time, valid] = Core::Common::Time::fromIsoZString(*point_.time);
+            if (!valid)
+                return fail("Invalid date/time format: " + *point_.time);
+
+            timeList_.emplace_back(time);
+            pointList_.emplace_back(Types::Track::Point::Latitude{*point_.latitude}, Types::Track::Point::Longitude{*point_.longitude});
+            headingList_.emplace_back(point_.course ? *point_.course : NAN);
+            velocityList_.emplace_back(*point_.speed / 3.6);
+            return true;
+        }
+
+        Types::Track::TimeList & timeList_;
+        Types::Track::PointList & pointList_;
+        Types::Track::HeadingList & headingList_;
+        Types::Track::VelocityList & velocityList_;
+        size_t depth_{0};
+        std::string key_;
+        Point point_;
+        std::string error_;
+    };
+
+}  // namespace
+
 JsonTrackReader::JsonTrackReader(std::istream & input) : input_(input)
 {
 }
@@ -27,27 +185,13 @@ bool JsonTrackReader::operator()(
 
     APP_LOG_TAG(noise, "I/O") << "Reading track";
 
-    nlohmann::json json;
-    input_ >> json;
-
-    for (auto const & data : json)
+    // The track points are added while they are parsed.
+    // Not strict, so like `operator>>` parsing stops after the track and ignores any content following it.
+    auto handler = TrackSaxHandler{timeList, pointList, headingList, velocityList};
+    if (!nlohmann::json::sax_parse(input_, &handler, nlohmann::json::input_format_t::json, false))
     {
-        auto [time, valid] = Core::Common::Time::fromIsoZString(data.at("pos_time"));
-        if (!valid)
-        {
-            APP_LOG(error) << "Invalid date/time format: " << data.at("pos_time");
-            APP_THROW_LOGGED_EXCEPTION();
-        }
-
-        timeList.emplace_back(time);
-        pointList.emplace_back(
-            Types::Track::Point::Latitude{data.at("latitude").get<Core::Common::Geometry::ValueType>()},
-            Types::Track::Point::Longitude{data.at("longitude").get<Core::Common::Geometry::ValueType>()});
-        if (data.find("course") != data.end())
-            headingList.emplace_back(data.at("course").get<Types::Track::Heading>());
-        else
-            headingList.emplace_back(NAN);
-        velocityList.emplace_back(data.at("speed").get<Types::Track::Velocity>() / 3.6);
+        APP_LOG(error) << handler.error();
+        APP_THROW_LOGGED_EXCEPTION();
     }
 
     return true;
@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Reader/MappedCsvTrackReader.h>
+
+#include <Core/Common/File/MappedFile.h>
+#include <Core/Common/Time/Helper.h>
+
+#include <Generic/String/Number.h>
+
+#include <amblog/global.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <optional>
+#include <string_view>
+#include <system_error>
+
+namespace AppComponents::Common::Reader {
+
+namespace {
+
+    std::string_view trimmed(std::string_view text)
+    {
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+            text.remove_prefix(1);
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+            text.remove_suffix(1);
+        return text;
+    }
+
+    /**
+     * Parses a floating point number like `std::stod` (the longest valid prefix counts), but without allocating.
+     * @return Nothing if the text does not start with a number or it is out of range.
+     */
+    std::optional<double> parseDouble(std::string_view text)
+    {
+        // `std::stod` accepts an explicit plus sign, `std::from_chars` does not.
+        if (text.size() > 1 && text.front() == '+' && text[1] != '-')
+            text.remove_prefix(1);
+
+        double value;
+        if (Generic::String::parseDouble(text, value) == 0)
+            return std::nullopt;
+        return value;
+    }
+
+    constexpr size_t columnCount = 5;
+
+    /**
+     * Splits a row like `Generic::String::readNextRow`, but only keeps the first columns.
+     * @return The number of cells of the row.
+     */
+    size_t splitRow(std::string_view row, char const separator, std::array<std::string_view, columnCount> & cells)
+    {
+        size_t cellCount = 0;
+        while (true)
+        {
+            auto const separatorPosition = row.find(separator);
+            if (cellCount < cells.size())
+                cells[cellCount] = trimmed(row.substr(0, separatorPosition));
+            ++cellCount;
+            if (separatorPosition == std::string_view::npos)
+                return cellCount;
+            row.remove_prefix(separatorPosition + 1);
+        }
+    }
+
+}  // namespace
+
+MappedCsvTrackReader::MappedCsvTrackReader(std::string const & fileName) : fileName_(fileName)
+{
+}
+
+bool MappedCsvTrackReader::operator()(
+    Common::Types::Track::TimeList & timeList,
+    Common::Types::Track::PointList & pointList,
+    Common::Types::Track::HeadingList & headingList,
+    Common::Types::Track::VelocityList & velocityList)
+{
+    using namespace Common;
+
+    APP_LOG_TAG(noise, "I/O") << "Reading track " << fileName_;
+
+    auto file = std::optional<Core::Common::File::MappedFile>{};
+    try
+    {
+        file.emplace(fileName_);
+    }
+    catch (std::system_error const & error)
+    {
+        APP_LOG(error) << error.what();
+        APP_THROW_LOGGED_EXCEPTION();
+    }
+    auto content = file->content();
+
+    auto const rowCount = static_cast<size_t>(std::count(content.begin(), content.end(), '\n')) + 1;
+    timeList.reserve(timeList.size() + rowCount);
+    pointList.reserve(pointList.size() + rowCount);
+    headingList.reserve(headingList.size() + rowCount);
+    velocityList.reserve(velocityList.size() + rowCount);
+
+    auto cells = std::array<std::string_view, columnCount>{};
+    auto parseNumber = [&](size_t const column)
+    {
+        auto const value = parseDouble(cells[column]);
+        if (!value)
+        {
+            APP_LOG(error) << "Invalid number format: " << cells[column];
+            APP_THROW_LOGGED_EXCEPTION();
+        }
+        return *value;
+    };
+
+    // Like the stream based reader, reading stops at the first row with too few columns (f.ex. an empty line).
+    while (!content.empty())
+    {
+        auto const rowEnd = content.find('\n');
+        auto const row = content.substr(0, rowEnd);
+        content.remove_prefix(rowEnd == std::string_view::npos ? content.size() : rowEnd + 1);
+
+        if (splitRow(row, ';', cells) < columnCount)
+            break;
+
+        auto try_time = Core::Common::Time::fromIsoString(cells[0]);
+        if (!try_time.second)
+        {
+            APP_LOG(error) << "Invalid date/time format: " << cells[0];
+            APP_THROW_LOGGED_EXCEPTION();
+        }
+
+        timeList.emplace_back(try_time.first);
+        pointList.emplace_back(Types::Track::Point::Latitude{parseNumber(1)}, Types::Track::Point::Longitude{parseNumber(2)});
+        headingList.emplace_back(parseNumber(3));
+        velocityList.emplace_back(parseNumber(4));
+    }
+
+    return true;
+}
+
+}  // namespace AppComponents::Common::Reader
@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "IReader.h"
+
+#include <AppComponents/Common/Types/Track/Heading.h>
+#include <AppComponents/Common/Types/Track/Point.h>
+#include <AppComponents/Common/Types/Track/Time.h>
+#include <AppComponents/Common/Types/Track/Velocity.h>
+
+#include <string>
+
+namespace AppComponents::Common::Reader {
+
+/**
+ * Reads the same format as the `CsvTrackReader` and produces the same lists, but from a file, which is memory mapped and parsed in place.
+ *
+ * Meant for large tracks, where the per-row allocations of the stream based reader dominate.
+ */
+class MappedCsvTrackReader : public ITrackReader
+{
+public:
+    MappedCsvTrackReader(std::string const & fileName);
+    bool operator()(
+        AppComponents::Common::Types::Track::TimeList &,
+        AppComponents::Common::Types::Track::PointList &,
+        AppComponents::Common::Types::Track::HeadingList &,
+        AppComponents::Common::Types::Track::VelocityList &);
+
+private:
+    std::string const fileName_;
+};
+
+}  // namespace AppComponents::Common::Reader
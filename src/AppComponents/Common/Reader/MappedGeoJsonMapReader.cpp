@@ -0,0 +1,271 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Reader/MappedGeoJsonMapReader.h>
+
+#include <AppComponents/Common/Reader/GeoJson/Conversion.h>
+
+#include <Core/Common/File/MappedFile.h>
+
+#include <Generic/Parallel/Parallel.h>
+
+#include <amblog/global.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace AppComponents::Common::Reader {
+
+namespace {
+
+    // Features handed to a thread at once, small enough to balance features of very different size.
+    constexpr size_t batchSize = 1024;
+
+    /**
+     * Locates the raw text of the features of a GeoJSON feature collection, without parsing their content.
+     *
+     * Only the structure (matching brackets and strings) is followed, the features are validated when they are parsed.
+     */
+    class FeatureScanner
+    {
+    public:
+        explicit FeatureScanner(std::string_view const text) : text_(text) {}
+
+        /// @throws std::domain_error If the text is no object with a `FeatureCollection` type and a `features` array.
+        std::vector<std::string_view> operator()()
+        {
+            auto type = std::optional<std::string_view>{};
+            auto features = std::optional<std::vector<std::string_view>>{};
+
+            expect('{');
+            if (!consume('}'))
+            {
+                do
+                {
+                    auto const key = string();
+                    expect(':');
+                    if (key == "type")
+                        type = string();
+                    else if (key == "features")
+                        features = elements();
+                    else
+                        skipValue();
+                } while (consume(','));
+                expect('}');
+            }
+
+            if (type != "FeatureCollection")
+                throw std::domain_error("'type' of JSON data has to be 'FeatureCollection' but is '" + std::string{type.value_or("")} + '\'');
+            if (!features)
+                throw std::domain_error("JSON data has no 'features'");
+            return std::move(*features);
+        }
+
+    private:
+        void skipWhitespace()
+        {
+            while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' || text_[pos_] == '\r'))
+                ++pos_;
+        }
+
+        bool consume(char const c)
+        {
+            skipWhitespace();
+            if (pos_ < text_.size() && text_[pos_] == c)
+            {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+
+        void expect(char const c)
+        {
+            if (!consume(c))
+                fail(std::string{"expected '"} + c + '\'');
+        }
+
+        [[noreturn]] void fail(std::string const & message) const
+        {
+            throw std::domain_error("Invalid GeoJSON at byte " + std::to_string(pos_) + ": " + message);
+        }
+
+        /// @return The raw content of a string (escape sequences are kept).
+        std::string_view string()
+        {
+            expect('"');
+            auto const begin = pos_;
+            skipStringContent();
+            return text_.substr(begin, pos_ - begin - 1);
+        }
+
+        /// Skips to behind the closing quote of a string, whose opening quote was consumed.
+        void skipStringContent()
+        {
+            while (pos_ < text_.size())
+            {
+                auto const c = text_[pos_++];
+                if (c == '\\')
+                    ++pos_;
+                else if (c == '"')
+                    return;
+            }
+            fail("unterminated string");
+        }
+
+        /// @return The raw text of each element of an array.
+        std::vector<std::string_view> elements()
+        {
+            auto result = std::vector<std::string_view>{};
+            expect('[');
+            if (consume(']'))
+                return result;
+            do
+            {
+                skipWhitespace();
+                auto const begin = pos_;
+                skipValue();
+                result.push_back(text_.substr(begin, pos_ - begin));
+            } while (consume(','));
+            expect(']');
+            return result;
+        }
+
+        void skipValue()
+        {
+            skipWhitespace();
+            if (pos_ == text_.size())
+                fail("expected a value");
+
+            auto const first = text_[pos_];
+            if (first == '"')
+            {
+                ++pos_;
+                skipStringContent();
+                return;
+            }
+            if (first != '{' && first != '[')
+            {
+                // A number or literal.
+                auto const begin = pos_;
+                while (pos_ < text_.size() && std::string_view{",:]} \t\n\r\""}.find(text_[pos_]) == std::string_view::npos)
+                    ++pos_;
+                if (pos_ == begin)
+                    fail("expected a value");
+                return;
+            }
+
+            // The closing brackets of the open objects and arrays, innermost last.
+            auto closing = std::string{};
+            while (pos_ < text_.size())
+            {
+                auto const c = text_[pos_++];
+                if (c == '"')
+                    skipStringContent();
+                else if (c == '{')
+                    closing.push_back('}');
+                else if (c == '[')
+                    closing.push_back(']');
+                else if (c == '}' || c == ']')
+                {
+                    if (c != closing.back())
+                    {
+                        --pos_;
+                        fail(std::string{"expected '"} + closing.back() + '\'');
+                    }
+                    closing.pop_back();
+                    if (closing.empty())
+                        return;
+                }
+            }
+            fail("unterminated " + std::string{first == '{' ? "object" : "array"});
+        }
+
+        std::string_view const text_;
+        size_t pos_{0};
+    };
+
+}  // namespace
+
+MappedGeoJsonMapReader::MappedGeoJsonMapReader(std::string const & fileName, size_t const threadCount)
+  : fileName_(fileName), threadCount_(threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+bool MappedGeoJsonMapReader::operator()(
+    Types::Street::SegmentList & segmentList,
+    Types::Street::NodePairList & nodePairList,
+    Types::Street::TravelDirectionList & travelDirectionList,
+    Types::Street::HighwayList & highwayList)
+{
+    APP_LOG_TAG(noise, "I/O") << "Reading map " << fileName_;
+
+    auto file = std::optional<Core::Common::File::MappedFile>{};
+    auto features = std::vector<std::string_view>{};
+    try
+    {
+        file.emplace(fileName_);
+        features = FeatureScanner{file->content()}();
+    }
+    catch (std::exception const & error)
+    {
+        APP_LOG(error) << error.what();
+        APP_THROW_LOGGED_EXCEPTION();
+    }
+
+    // The number of features is known before they are decoded, so each thread writes its features in place.
+    auto const offset = segmentList.size();
+    segmentList.resize(offset + features.size());
+    nodePairList.resize(offset + features.size());
+    travelDirectionList.resize(offset + features.size());
+    highwayList.resize(offset + features.size());
+
+    try
+    {
+        Generic::Parallel::forEachBatch(
+            features.size(),
+            batchSize,
+            threadCount_,
+            [&](size_t const begin, size_t const end)
+            {
+                for (auto index = begin; index < end; ++index)
+                {
+                    try
+                    {
+                        auto feature = GeoJson::toFeature(nlohmann::json::parse(features[index].begin(), features[index].end()));
+                        segmentList[offset + index] = std::move(feature.segment);
+                        nodePairList[offset + index] = feature.nodePair;
+                        travelDirectionList[offset + index] = feature.travelDirection;
+                        highwayList[offset + index] = feature.highway;
+                    }
+                    catch (std::exception const & error)
+                    {
+                        throw std::runtime_error("Feature " + std::to_string(index) + ": " + error.what());
+                    }
+                }
+            });
+    }
+    catch (std::exception const & error)
+    {
+        APP_LOG(error) << error.what();
+        APP_THROW_LOGGED_EXCEPTION();
+    }
+
+    APP_LOG_MS(noise) << segmentList.size() << " street segments created";
+
+    return true;
+}
+
+}  // namespace AppComponents::Common::Reader
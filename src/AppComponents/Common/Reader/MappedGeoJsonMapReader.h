@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "IReader.h"
+
+#include <AppComponents/Common/Types/Street/Highway.h>
+#include <AppComponents/Common/Types/Street/NodePair.h>
+#include <AppComponents/Common/Types/Street/Segment.h>
+#include <AppComponents/Common/Types/Street/TravelDirection.h>
+
+#include <cstddef>
+#include <string>
+
+namespace AppComponents::Common::Reader {
+
+/**
+ * Reads the same format as the `GeoJsonMapReader` and produces the same lists, but from a file, which is memory mapped and decoded feature by feature.
+ *
+ * The feature collection is never held as one JSON document: the raw text of the features is located in the mapping,
+ * and batches of features are parsed by several threads, each feature on its own.
+ * Meant for large (f.ex. region) maps, where the JSON document of the stream based reader needs several times the memory of the file.
+ */
+class MappedGeoJsonMapReader : public IMapReader
+{
+public:
+    /// @param threadCount Number of threads decoding features, 0 to use one per hardware thread.
+    MappedGeoJsonMapReader(std::string const & fileName, size_t threadCount = 0);
+    bool operator()(
+        Types::Street::SegmentList &,
+        Types::Street::NodePairList &,
+        Types::Street::TravelDirectionList &,
+        Types::Street::HighwayList &
+        );
+
+private:
+    std::string const fileName_;
+    size_t const threadCount_;
+};
+
+}  // namespace AppComponents::Common::Reader
@@ -0,0 +1,275 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Reader/Osm/UniquePoints.h>
+
+#include <Core/Common/Geometry/Helper.h>
+#include <Core/Common/Geometry/NumericConstants.h>
+
+#include <Generic/Map/FlatHashMap.h>
+#include <Generic/Parallel/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <utility>
+
+namespace AppComponents::Common::Reader::Osm {
+
+namespace {
+
+    // Clusters of coordinates handed to a thread at once.
+    constexpr size_t batchSize = 1024;
+
+    // The grid cells are slightly higher than the merge distance, so rounding can not move points within the merge distance further than to the neighbouring row.
+    constexpr double cellDegrees = 1.001 * maxMergeDistanceInMeters / (Core::Common::Geometry::equatorRadiusMeter * Core::Common::Geometry::piover180);
+    // Limits the columns to check next to the poles.
+    constexpr double minCosLatitude = 0.001;
+
+    std::int64_t cell(double const degrees)
+    {
+        return static_cast<std::int64_t>(std::floor(degrees / cellDegrees));
+    }
+
+    /// Cells are ordered row by row, so the keys of neighbouring columns are consecutive.
+    std::uint64_t cellKey(std::int64_t const column, std::int64_t const row)
+    {
+        constexpr std::int64_t bias = std::int64_t{1} << 31;
+        return static_cast<std::uint64_t>(row + bias) << 32 | static_cast<std::uint64_t>(column + bias);
+    }
+
+    std::uint64_t cellKey(Core::Common::Geometry::Point const & point)
+    {
+        return cellKey(cell(point.lon()), cell(point.lat()));
+    }
+
+    /**
+     * @return How many columns apart points of the rows \p row1 and \p row2 can be and still be within the merge distance (the same from both rows).
+     */
+    std::int64_t columnsWithinMergeDistance(std::int64_t const row1, std::int64_t const row2)
+    {
+        // Degrees of longitude get shorter towards the poles, so the merge distance spans more columns.
+        auto const maxRow = std::max({std::abs(row1), std::abs(row1 + 1), std::abs(row2), std::abs(row2 + 1)});
+        auto const latitude = std::min(90.0, static_cast<double>(maxRow) * cellDegrees);
+        return static_cast<std::int64_t>(std::ceil(1.0 / std::max(std::cos(latitude * Core::Common::Geometry::piover180), minCosLatitude)));
+    }
+
+    /**
+     * Merges points which are 10cm or less apart, in the order they are inserted.
+     *
+     * The points are hashed into a grid of cells which are as high as the merge distance (and at most as wide),
+     * so a point is only compared to the points in the neighbouring cells.
+     */
+    class UniquePointGrid
+    {
+    public:
+        /**
+         * @return The index of the inserted point nearest to \p point within the merge distance, or of \p point, which is inserted if there is none.
+         */
+        size_t insert(Core::Common::Geometry::Point const & point)
+        {
+            auto const row = cell(point.lat());
+            auto const column = cell(point.lon());
+
+            auto nearest = npos;
+            auto nearestDistance = maxMergeDistanceInMeters;
+            for (auto neighbourRow = row - 1; neighbourRow <= row + 1; ++neighbourRow)
+            {
+                auto const columns = columnsWithinMergeDistance(row, neighbourRow);
+                for (auto neighbourColumn = column - columns; neighbourColumn <= column + columns; ++neighbourColumn)
+                {
+                    auto const it = firstPointOfCell_.find(cellKey(neighbourColumn, neighbourRow));
+                    if (it == firstPointOfCell_.end())
+                        continue;
+                    for (auto index = it->second; index != npos; index = nextPointOfCell_[index])
+                    {
+                        auto const distance = Core::Common::Geometry::geoDistance(points_[index], point);
+                        if (distance <= nearestDistance)
+                        {
+                            nearest = index;
+                            nearestDistance = distance;
+                        }
+                    }
+                }
+            }
+            if (nearest != npos)
+                return nearest;
+
+            auto const index = points_.size();
+            auto & first = firstPointOfCell_.try_emplace(cellKey(column, row), npos).first->second;
+            points_.push_back(point);
+            nextPointOfCell_.push_back(first);
+            first = index;
+            return index;
+        }
+
+        size_t size() const { return points_.size(); }
+
+    private:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        Generic::FlatHashMap<std::uint64_t, size_t> firstPointOfCell_;
+        std::vector<Core::Common::Geometry::Point> points_;
+        std::vector<size_t> nextPointOfCell_;
+    };
+
+}  // namespace
+
+UniquePoints mergeCoordinates(std::vector<Core::Common::Geometry::Point> const & coordinates, size_t const threadCount)
+{
+    using Generic::Parallel::forEachBatch;
+
+    // { cell key, coordinate index }, sorted by cell and then in coordinate order
+    auto keys = std::vector<std::pair<std::uint64_t, size_t>>(coordinates.size());
+    forEachBatch(
+        coordinates.size(),
+        batchSize,
+        threadCount,
+        [&](size_t const begin, size_t const end)
+        {
+            for (auto index = begin; index < end; ++index)
+                keys[index] = {cellKey(coordinates[index]), index};
+        });
+    Generic::Parallel::sort(keys.begin(), keys.end(), std::less<>{}, threadCount);
+
+    // The coordinates of cell `i` are `keys[firstKeyOfCell[i]]` to `keys[firstKeyOfCell[i + 1] - 1]`.
+    auto cellKeys = std::vector<std::uint64_t>{};
+    auto firstKeyOfCell = std::vector<size_t>{};
+    for (size_t index = 0; index < keys.size(); ++index)
+        if (index == 0 || keys[index].first != keys[index - 1].first)
+        {
+            cellKeys.push_back(keys[index].first);
+            firstKeyOfCell.push_back(index);
+        }
+    firstKeyOfCell.push_back(keys.size());
+
+    auto forEachNeighbour = [&](size_t const cellIndex, auto const & function)
+    {
+        auto const row = static_cast<std::int64_t>(cellKeys[cellIndex] >> 32) - (std::int64_t{1} << 31);
+        auto const column = static_cast<std::int64_t>(cellKeys[cellIndex] & 0xffffffffu) - (std::int64_t{1} << 31);
+        for (auto neighbourRow = row - 1; neighbourRow <= row + 1; ++neighbourRow)
+        {
+            auto const columns = columnsWithinMergeDistance(row, neighbourRow);
+            auto const last = cellKey(column + columns, neighbourRow);
+            for (auto it = std::lower_bound(cellKeys.begin(), cellKeys.end(), cellKey(column - columns, neighbourRow)); it != cellKeys.end() && *it <= last; ++it)
+                function(static_cast<size_t>(it - cellKeys.begin()));
+        }
+    };
+
+    // Neighbouring cells are looked up in parallel, but are rare (junctions are usually one cell), so they are joined to clusters afterwards.
+    auto neighboursOfBatch = std::vector<std::vector<std::pair<size_t, size_t>>>((cellKeys.size() + batchSize - 1) / batchSize);
+    forEachBatch(
+        cellKeys.size(),
+        batchSize,
+        threadCount,
+        [&](size_t const begin, size_t const end)
+        {
+            auto & neighbours = neighboursOfBatch[begin / batchSize];
+            for (auto cellIndex = begin; cellIndex < end; ++cellIndex)
+                forEachNeighbour(
+                    cellIndex,
+                    [&](size_t const neighbour)
+                    {
+                        if (neighbour < cellIndex)
+                            neighbours.emplace_back(cellIndex, neighbour);
+                    });
+        });
+    // The cluster of a cell is the smallest cell index of the cluster.
+    auto clusterOfCell = std::vector<size_t>(cellKeys.size());
+    std::iota(clusterOfCell.begin(), clusterOfCell.end(), size_t{0});
+    auto findCluster = [&](size_t cellIndex)
+    {
+        while (clusterOfCell[cellIndex] != cellIndex)
+            cellIndex = clusterOfCell[cellIndex] = clusterOfCell[clusterOfCell[cellIndex]];
+        return cellIndex;
+    };
+    for (auto const & neighbours : neighboursOfBatch)
+        for (auto const & [cellIndex, neighbour] : neighbours)
+        {
+            auto const cluster = findCluster(cellIndex);
+            auto const neighbourCluster = findCluster(neighbour);
+            clusterOfCell[std::max(cluster, neighbourCluster)] = std::min(cluster, neighbourCluster);
+        }
+    for (size_t cellIndex = 0; cellIndex < cellKeys.size(); ++cellIndex)
+        clusterOfCell[cellIndex] = findCluster(cellIndex);
+
+    // { cluster, cell index }, sorted by cluster
+    auto cellsByCluster = std::vector<std::pair<size_t, size_t>>(cellKeys.size());
+    for (size_t cellIndex = 0; cellIndex < cellKeys.size(); ++cellIndex)
+        cellsByCluster[cellIndex] = {clusterOfCell[cellIndex], cellIndex};
+    Generic::Parallel::sort(cellsByCluster.begin(), cellsByCluster.end(), std::less<>{}, threadCount);
+    auto firstCellOfCluster = std::vector<size_t>{};
+    for (size_t index = 0; index < cellsByCluster.size(); ++index)
+        if (index == 0 || cellsByCluster[index].first != cellsByCluster[index - 1].first)
+            firstCellOfCluster.push_back(index);
+    firstCellOfCluster.push_back(cellsByCluster.size());
+
+    auto result = UniquePoints{std::vector<size_t>(coordinates.size()), std::vector<UniquePoint>(coordinates.size()), 0};
+    auto count = std::atomic<size_t>{0};
+    forEachBatch(
+        firstCellOfCluster.size() - 1,
+        batchSize,
+        threadCount,
+        [&](size_t const begin, size_t const end)
+        {
+            auto clusterCoordinates = std::vector<size_t>{};
+            auto firstCoordinates = std::vector<size_t>{};
+            for (auto cluster = begin; cluster < end; ++cluster)
+            {
+                clusterCoordinates.clear();
+                for (auto index = firstCellOfCluster[cluster]; index < firstCellOfCluster[cluster + 1]; ++index)
+                {
+                    auto const cellIndex = cellsByCluster[index].second;
+                    for (auto key = firstKeyOfCell[cellIndex]; key < firstKeyOfCell[cellIndex + 1]; ++key)
+                        clusterCoordinates.push_back(keys[key].second);
+                }
+                std::sort(clusterCoordinates.begin(), clusterCoordinates.end());
+
+                firstCoordinates.clear();
+                auto merge = [&](size_t const coordinate, size_t const uniquePoint)
+                {
+                    if (uniquePoint == firstCoordinates.size())
+                        firstCoordinates.push_back(coordinate);
+                    auto const firstCoordinate = firstCoordinates[uniquePoint];
+                    result.ofCoordinate[coordinate] = firstCoordinate;
+                    result.points[firstCoordinate].id = coordinate;
+                    ++result.points[firstCoordinate].coordinateCount;
+                };
+                // Clusters are usually a single junction, comparing all of its points is cheaper than hashing them.
+                constexpr size_t maxCoordinatesWithoutGrid = 64;
+                if (clusterCoordinates.size() <= maxCoordinatesWithoutGrid)
+                    for (auto const coordinate : clusterCoordinates)
+                    {
+                        auto nearest = firstCoordinates.size();
+                        auto nearestDistance = maxMergeDistanceInMeters;
+                        for (size_t uniquePoint = 0; uniquePoint < firstCoordinates.size(); ++uniquePoint)
+                        {
+                            auto const distance = Core::Common::Geometry::geoDistance(coordinates[firstCoordinates[uniquePoint]], coordinates[coordinate]);
+                            if (distance <= nearestDistance)
+                            {
+                                nearest = uniquePoint;
+                                nearestDistance = distance;
+                            }
+                        }
+                        merge(coordinate, nearest);
+                    }
+                else
+                {
+                    auto grid = UniquePointGrid{};
+                    for (auto const coordinate : clusterCoordinates)
+                        merge(coordinate, grid.insert(coordinates[coordinate]));
+                }
+                count += firstCoordinates.size();
+            }
+        });
+    result.count = count;
+    return result;
+}
+
+}  // namespace AppComponents::Common::Reader::Osm
@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <Core/Common/Geometry/Types.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace AppComponents::Common::Reader::Osm {
+
+/// Coordinates of lines which are this close or closer are merged into one point.
+constexpr double maxMergeDistanceInMeters = 0.1;
+
+/**
+ * A point shared by the coordinates of lines which are 10cm or less apart.
+ */
+struct UniquePoint
+{
+    /**
+     * Index of the last of its coordinates, the id the former per coordinate counter ended with.
+     * Ids are only used as node ids of the street graph, so they need to be unique but not consecutive.
+     */
+    size_t id;
+    size_t coordinateCount;  ///< More than one coordinate means a junction (or a line crossing itself).
+};
+
+struct UniquePoints
+{
+    std::vector<size_t> ofCoordinate;  ///< Index of the unique point of each coordinate, which is the index of its first coordinate.
+    std::vector<UniquePoint> points;   ///< Indexed like the coordinates, only the entries of the first coordinates of unique points are used.
+    size_t count{0};
+};
+
+/**
+ * Merges coordinates which are 10cm or less apart into unique points.
+ *
+ * Each coordinate is merged into the nearest unique point of the preceding coordinates within the merge distance, or starts a new unique point.
+ * The coordinates are sorted by grid cell, and cells within the merge distance of each other are grouped to clusters.
+ * Coordinates of different clusters are too far apart to be merged, so the clusters are merged independently (in parallel),
+ * with the same result as merging all coordinates one after another.
+ */
+UniquePoints mergeCoordinates(std::vector<Core::Common::Geometry::Point> const & coordinates, size_t threadCount);
+
+}  // namespace AppComponents::Common::Reader::Osm
@@ -7,41 +7,37 @@
  */
 
 #include <AppComponents/Common/Reader/Osm/Conversion.h>
+#include <AppComponents/Common/Reader/Osm/UniquePoints.h>
 #include <AppComponents/Common/Reader/OsmMapReader.h>
 
 #include <Core/Common/Geometry/Conversion.h>
 #include <Core/Common/Geometry/Helper.h>
 #include <Core/Common/Postgres/Helper.h>
 
+#include <Generic/Parallel/Parallel.h>
 #include <Generic/String/Split.h>
 
 #include <amblog/global.h>
 #include <pqxx/pqxx>
 
 #include <boost/algorithm/string/replace.hpp>
-#include <boost/geometry/index/rtree.hpp>
-#include <boost/iterator/function_output_iterator.hpp>
-
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
 #include <iomanip>
 #include <iterator>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace AppComponents::Common::Reader {
 
 namespace {
 
-    struct PointLocation
-    {
-        size_t osmLineId;
-        size_t pointIndex;
-    };
-
-    struct UniquePoint
-    {
-        size_t id;
-        std::vector<PointLocation> locations;
-    };
+    // Lines, coordinates or clusters of coordinates handed to a thread at once, small enough to balance lines of very different length.
+    constexpr size_t batchSize = 1024;
 
     struct OsmPointCandidate
     {
@@ -66,83 +62,46 @@ namespace {
     {
         OsmLineCandidate segment;
         std::vector<size_t> osmPointIds;
+        size_t firstCoordinate;  ///< The coordinates of all candidates are numbered line by line.
     };
 
-    using PointGeoindexValue = std::pair<Core::Common::Geometry::Point, std::shared_ptr<UniquePoint>>;
-    using PointGeoindexAlgorithm = boost::geometry::index::quadratic<16>;
-    using PointGeoindex = boost::geometry::index::rtree<PointGeoindexValue, PointGeoindexAlgorithm>;
-
-    /**
-     * Points are considered equal if the distance is 10cm or less.
-     */
-    std::shared_ptr<UniquePoint> getUniquePoint(PointGeoindex & geoindex, Core::Common::Geometry::Point point)
-    {
-        unsigned const k_nearest = 1;
-        double const maxDistanceInMeters = 0.1;
-        auto result = std::optional<PointGeoindexValue>{};
-        auto inserter = [&](PointGeoindexValue const & value)
-        {
-            if (geoDistance(value.first, point) <= maxDistanceInMeters)
-                result = value;
-        };
-        geoindex.query(boost::geometry::index::nearest(point, k_nearest), boost::make_function_output_iterator(inserter));
-        if (not result)
-        {
-            result = PointGeoindexValue{point, std::make_shared<UniquePoint>()};
-            geoindex.insert(*result);
-        }
-        return result->second;
-    }
-
     /**
      * @param records The query should have returned lines and points pairwise sequentially (multiply line data),
      *   like { { line1, point1 }, { line1, point2 }, { line2, point1 }, ... }.
-     * @return { candidates, osmPointMap, geoindex }
+     * @param partIndices If given, receives the corridor parts near each line, which a batch query returns as comma separated `line_parts`.
      */
-    std::tuple<std::vector<Candidate>, std::unordered_map<size_t, OsmPointCandidate>, PointGeoindex> getCandidates(pqxx::result & records)
+    std::vector<OsmLineCandidate> readLines(pqxx::result const & records, std::vector<std::vector<size_t>> * partIndices = nullptr)
     {
         using namespace Core::Common::Geometry;
         using namespace Core::Common::Postgres;
         using namespace AppComponents::Common::Reader::Osm;
 
-        auto candidates = std::vector<Candidate>{};
-        auto osmPointMap = std::unordered_map<size_t, OsmPointCandidate>{};
-        auto geoindex = PointGeoindex{};
-
-        auto currentSegment = std::optional<OsmLineCandidate>{};
-        auto currentNodes = std::vector<size_t>{};
-
-        size_t nextPointId = 0;
-        auto addCurrentStreet = [&]()
-        {
-            assert(currentSegment);
-            for (size_t i = 0; i < currentSegment->segment.geometry.size(); ++i)
-            {
-                auto & uniquePoint = *getUniquePoint(geoindex, currentSegment->segment.geometry[i]);
-                uniquePoint.id = nextPointId++;  // TODO: only increment if a new UniquePoint was created?
-                uniquePoint.locations.push_back(PointLocation{currentSegment->segment.originId, i});
-            }
-            candidates.push_back(Candidate{std::move(*currentSegment), std::move(currentNodes)});
-            currentSegment.reset();
-            currentNodes.clear();
-        };
-
+        auto lines = std::vector<OsmLineCandidate>{};
         for (auto const & row : records)
         {
             auto segmentIdRaw = row.at("line_id").as<int64_t>();
             size_t segmentId = segmentIdRaw >= 0 ? static_cast<size_t>(segmentIdRaw) : static_cast<size_t>(-segmentIdRaw);
-            if (not currentSegment || currentSegment->segment.originId != segmentId)
+            if (lines.empty() || lines.back().segment.originId != segmentId)
             {
-                if (currentSegment)
-                    addCurrentStreet();
-                auto way = row.at("line_way").as<std::string>();
+                // The geometry is fetched as WKB, which is decoded without formatting and parsing decimal text.
+                auto way = row.at("line_way").as<std::basic_string<std::byte>>();
                 auto oneway = getOptional(row.at("line_oneway"), std::string{});
-                currentSegment = OsmLineCandidate{
-                    {segmentId, 0, toLineString(way)}, toTravelDirection(oneway), toHighway(row.at("line_highway").as<std::string>())
+                lines.push_back(OsmLineCandidate{
+                    {segmentId, 0, wkbToLineString(way)}, toTravelDirection(oneway), toHighway(row.at("line_highway").as<std::string>())
                     //getOptional( row.at( "line_layer" ), std::string{} ),
                     //getOptional( row.at( "line_level" ), std::string{} ),
                     //getOptional( row.at( "line_location" ), std::string{} )
-                };
+                });
+                if (partIndices)
+                {
+                    auto & indices = partIndices->emplace_back();
+                    auto const text = row.at("line_parts").view();
+                    for (auto it = text.data(), end = text.data() + text.size(); it < end; ++it)
+                    {
+                        auto & index = indices.emplace_back();
+                        it = std::from_chars(it, end, index).ptr;
+                    }
+                }
             }
             /*
             auto osmPointId = getOptional<size_t>( row.at( "point_id" ) );
@@ -169,62 +128,125 @@ namespace {
             }
             */
         }
-        if (currentSegment)
-            addCurrentStreet();
+        return lines;
+    }
 
-        return {std::move(candidates), std::move(osmPointMap), std::move(geoindex)};
+    /**
+     * @return { candidates, osmPointMap, uniquePoints }
+     */
+    std::tuple<std::vector<Candidate>, std::unordered_map<size_t, OsmPointCandidate>, Osm::UniquePoints> getCandidates(std::vector<OsmLineCandidate> lines, size_t const threadCount)
+    {
+        auto candidates = std::vector<Candidate>{};
+        auto osmPointMap = std::unordered_map<size_t, OsmPointCandidate>{};
+
+        candidates.reserve(lines.size());
+        size_t coordinateCount = 0;
+        for (auto & line : lines)
+        {
+            auto const lineCoordinateCount = line.segment.geometry.size();
+            candidates.push_back(Candidate{std::move(line), {}, coordinateCount});
+            coordinateCount += lineCoordinateCount;
+        }
+
+        auto coordinates = std::vector<Core::Common::Geometry::Point>(coordinateCount);
+        Generic::Parallel::forEachBatch(
+            candidates.size(),
+            batchSize,
+            threadCount,
+            [&](size_t const begin, size_t const end)
+            {
+                for (auto index = begin; index < end; ++index)
+                {
+                    auto const & geometry = candidates[index].segment.segment.geometry;
+                    std::copy(geometry.begin(), geometry.end(), coordinates.begin() + static_cast<std::ptrdiff_t>(candidates[index].firstCoordinate));
+                }
+            });
+        auto uniquePoints = Osm::mergeCoordinates(coordinates, threadCount);
+
+        return {std::move(candidates), std::move(osmPointMap), std::move(uniquePoints)};
     }
 
     /**
+     * The streets of each candidate are counted before they are created, so the candidates are processed in parallel and write their streets in place,
+     * in the order of the candidates.
      *
      * @param candidates
      * @param osmPointMap
-     * @param geoindex
+     * @param uniquePoints The unique points the coordinates of the candidates were merged to.
      * @param splitOnOverlappingPoints If true, candidates are split on shared point intersections.
      */
     std::tuple<Types::Street::SegmentList, Types::Street::NodePairList, Types::Street::TravelDirectionList, Types::Street::HighwayList> processCandidates(
         std::vector<Candidate> const & candidates,
         std::unordered_map<size_t, OsmPointCandidate> const & osmPointMap [[gnu::unused]],
-        PointGeoindex & geoindex,
-        bool const splitOnOverlappingPoints)
+        Osm::UniquePoints const & uniquePoints,
+        bool const splitOnOverlappingPoints,
+        size_t const threadCount)
     {
-        Types::Street::SegmentList segmentList;
-        Types::Street::NodePairList nodePairList;
-        Types::Street::TravelDirectionList travelDirectionList;
-        Types::Street::HighwayList highwayList;
-
-        auto addStreet = [&](OsmLineCandidate segmentCandidate, size_t firstPointIndex, size_t lastPointIndex, size_t firstPointId, size_t lastPointId)
+        auto uniquePointOf = [&](Candidate const & candidate, size_t const pointIndex) -> Osm::UniquePoint const &
+        { return uniquePoints.points[uniquePoints.ofCoordinate[candidate.firstCoordinate + pointIndex]]; };
+        auto isJunction = [&](Candidate const & candidate, size_t const pointIndex)
         {
-            Types::Street::Segment segment;
-            segment.originId = segmentCandidate.segment.originId;
-            segment.originOffset = firstPointIndex;
-            for (size_t i = firstPointIndex; i <= lastPointIndex; ++i)
-                segment.geometry.push_back(segmentCandidate.segment.geometry[i]);
-            segmentList.push_back(segment);
-            nodePairList.emplace_back(firstPointId, lastPointId);
-            travelDirectionList.push_back(segmentCandidate.travelDirection);
-            highwayList.push_back(segmentCandidate.highway);
+            // Streets are only split on inner points.
+            return splitOnOverlappingPoints && pointIndex > 0 && pointIndex + 1 < candidate.segment.segment.geometry.size()
+                && uniquePointOf(candidate, pointIndex).coordinateCount > 1;
         };
 
-        for (auto const & candidate : candidates)
-        {
-            size_t firstPointIndex = 0;
-            size_t firstPointId = getUniquePoint(geoindex, candidate.segment.segment.geometry[firstPointIndex])->id;
-            if (splitOnOverlappingPoints)
-                for (size_t i = 1; i < candidate.segment.segment.geometry.size() - 1; ++i)
+        // The streets of candidate `i` start at `firstStreet[i]`.
+        auto firstStreet = std::vector<size_t>(candidates.size() + 1, 0);
+        Generic::Parallel::forEachBatch(
+            candidates.size(),
+            batchSize,
+            threadCount,
+            [&](size_t const begin, size_t const end)
+            {
+                for (auto index = begin; index < end; ++index)
                 {
-                    auto & uniquePoint = *getUniquePoint(geoindex, candidate.segment.segment.geometry[i]);
-                    if (uniquePoint.locations.size() > 1)  // split street on junction
+                    size_t streetCount = 1;
+                    for (size_t i = 0; i < candidates[index].segment.segment.geometry.size(); ++i)
+                        if (isJunction(candidates[index], i))
+                            ++streetCount;
+                    firstStreet[index + 1] = streetCount;
+                }
+            });
+        std::partial_sum(firstStreet.begin(), firstStreet.end(), firstStreet.begin());
+
+        Types::Street::SegmentList segmentList(firstStreet.back());
+        Types::Street::NodePairList nodePairList;
+        nodePairList.resize(firstStreet.back());
+        Types::Street::TravelDirectionList travelDirectionList(firstStreet.back());
+        Types::Street::HighwayList highwayList(firstStreet.back());
+
+        Generic::Parallel::forEachBatch(
+            candidates.size(),
+            batchSize,
+            threadCount,
+            [&](size_t const begin, size_t const end)
+            {
+                for (auto index = begin; index < end; ++index)
+                {
+                    auto const & candidate = candidates[index];
+                    auto const & geometry = candidate.segment.segment.geometry;
+                    auto street = firstStreet[index];
+                    size_t firstPointIndex = 0;
+                    auto addStreet = [&](size_t const lastPointIndex)
                     {
-                        addStreet(candidate.segment, firstPointIndex, i, firstPointId, uniquePoint.id);
-                        firstPointIndex = i;
-                        firstPointId = uniquePoint.id;
-                    }
+                        auto & segment = segmentList[street];
+                        segment.originId = candidate.segment.segment.originId;
+                        segment.originOffset = firstPointIndex;
+                        segment.geometry.assign(geometry.begin() + static_cast<std::ptrdiff_t>(firstPointIndex), geometry.begin() + static_cast<std::ptrdiff_t>(lastPointIndex + 1));
+                        nodePairList[street] = {uniquePointOf(candidate, firstPointIndex).id, uniquePointOf(candidate, lastPointIndex).id};
+                        travelDirectionList[street] = candidate.segment.travelDirection;
+                        highwayList[street] = candidate.segment.highway;
+                        ++street;
+                        firstPointIndex = lastPointIndex;
+                    };
+
+                    for (size_t i = 1; i + 1 < geometry.size(); ++i)
+                        if (isJunction(candidate, i))  // split street on junction
+                            addStreet(i);
+                    addStreet(geometry.size() - 1);
                 }
-            size_t lastPointIndex = candidate.segment.segment.geometry.size() - 1;
-            size_t lastPointId = getUniquePoint(geoindex, candidate.segment.segment.geometry[lastPointIndex])->id;
-            addStreet(candidate.segment, firstPointIndex, lastPointIndex, firstPointId, lastPointId);
-        }
+            });
 
         return {std::move(segmentList), std::move(nodePairList), std::move(travelDirectionList), std::move(highwayList)};
     }
@@ -326,6 +348,29 @@ namespace {
         }
     }
 
+    // GPS granularity is 2m, allow half of it since it can be left and right
+    constexpr double trackSimplificationDistance = 1.0;
+
+    /// Simplifies a track for a corridor query, the corridor has to be widened by `trackSimplificationDistance`.
+    Types::Track::PointList simplifyTrack(Types::Track::PointList const & pointList)
+    {
+        // ToDo: With correct type handling and inheritance the boost::geometry::simplify can be used directly
+        auto simplified = Types::Track::PointList{};
+        douglas_peucker_(pointList, simplified, trackSimplificationDistance);
+        return simplified;
+    }
+
+    /**
+     * @return The name of a prepared statement, which is unique per highway selection, because the selection is part of the statement.
+     */
+    std::string statementName(std::string const & prefix, std::unordered_set<Types::Street::HighwayType> const & highwaySelection)
+    {
+        unsigned long mask = 0;
+        for (auto const highway : highwaySelection)
+            mask |= 1ul << static_cast<unsigned>(highway);
+        return prefix + '_' + std::to_string(mask);
+    }
+
 }  // namespace
 
 OsmMapReader::OsmMapReader(
@@ -333,9 +378,10 @@ OsmMapReader::OsmMapReader(
     std::unordered_set<Types::Street::HighwayType> const & highwaySelection,
     double const fetchCorridor,
     bool const useSingleSearchCircle,
-    bool const splitOnOverlappingPoints)
+    bool const splitOnOverlappingPoints,
+    size_t const threadCount)
   : connection_(connection), highwaySelection_(highwaySelection), fetchCorridor_(fetchCorridor), useSingleSearchCircle_(useSingleSearchCircle),
-    splitOnOverlappingPoints_(splitOnOverlappingPoints)
+    splitOnOverlappingPoints_(splitOnOverlappingPoints), threadCount_(threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency()))
 {
 }
 
@@ -350,15 +396,8 @@ bool OsmMapReader::init(
     std::string pointsString;
     if (!useSingleSearchCircle_)
     {
-        // Simplify Track
-        // ToDo: With correct type handling and inheritance the boost::geometry::simplify can be used directly
-        typedef boost::geometry::model::d2::point_xy<double> xy;
-        float maxDistance = 1.0; // GPS granularity is 2m, allow half of it since it can be left and right
-        AppComponents::Common::Types::Track::PointList simplified{};
-        douglas_peucker_(pointList, simplified, maxDistance);
-
-        searchRadius_ = fetchCorridor_ + maxDistance;
-        pointsString_ = Geometry::toWkt(simplified);
+        searchRadius_ = fetchCorridor_ + trackSimplificationDistance;
+        pointsString_ = Geometry::toWkt(simplifyTrack(pointList));
     }
     else
     {
@@ -475,7 +514,7 @@ bool OsmMapReader::operator()(
             line.osm_id  line_id,
             line.oneway  line_oneway,
             line.highway line_highway,
-            ST_AsText( ST_Transform( line.way, 4326 ) )  line_way
+            ST_AsBinary( ST_Transform( line.way, 4326 ) )  line_way
         from
             planet_osm_line  line
         where
@@ -483,16 +522,17 @@ bool OsmMapReader::operator()(
             and ST_DWithin( ST_Transform( ST_GeomFromText( $1, 4326 ), 32632 ), line.way, $2 )
         )sql"};
     boost::replace_all(query, "$HIGHWAY_CONDITION", toHighwaySelectionSql(highwaySelection_, "line"));
-    dbConnection->prepare("", query);
-    pqxx::result records = dbTransaction.exec_prepared("", pointsString_, searchRadius_);
+    auto const statement = statementName("osm_map_reader_lines", highwaySelection_);
+    dbConnection->prepareOnce(statement, query);
+    pqxx::result records = dbTransaction.exec_prepared(statement, pointsString_, searchRadius_);
 
     APP_LOG_TAG_MS(noise, "DB") << records.size() << " records were read";
 
-    auto [candidates, osmPointMap, geoindex] = getCandidates(records);
+    auto [candidates, osmPointMap, uniquePoints] = getCandidates(readLines(records), threadCount_);
 
-    APP_LOG_TAG_MS(noise, "DB") << candidates.size() << " lines, " << osmPointMap.size() << " points and " << geoindex.size() << " coordinates fetched";
+    APP_LOG_TAG_MS(noise, "DB") << candidates.size() << " lines, " << osmPointMap.size() << " points and " << uniquePoints.count << " coordinates fetched";
 
-    std::tie(segmentList, nodePairList, travelDirectionList, highwayList) = processCandidates(candidates, osmPointMap, geoindex, splitOnOverlappingPoints_);
+    std::tie(segmentList, nodePairList, travelDirectionList, highwayList) = processCandidates(candidates, osmPointMap, uniquePoints, splitOnOverlappingPoints_, threadCount_);
 
     APP_LOG_MS(noise) << segmentList.size() << " street segments created";
 
@@ -511,4 +551,80 @@ bool OsmMapReader::operator()(
     return this->operator()(segmentList, nodePairList, travelDirectionList, highwayList);
 }
 
+std::vector<OsmMapReader::StreetMap> OsmMapReader::readBatch(std::vector<Types::Track::PointList> const & trackList)
+{
+    using namespace Core::Common;
+    using namespace AppComponents::Common::Reader::Osm;
+
+    // Empty tracks have no corridor, so they are left out of the query and the parts of the corridor are mapped to their tracks.
+    auto corridor = std::vector<std::vector<Geometry::Point>>{};
+    auto trackOfPart = std::vector<size_t>{};
+    for (size_t trackIndex = 0; trackIndex < trackList.size(); ++trackIndex)
+    {
+        if (trackList[trackIndex].empty())
+            continue;
+        auto simplified = simplifyTrack(trackList[trackIndex]);
+        // A line string needs two points.
+        if (simplified.size() == 1)
+            simplified.push_back(simplified.front());
+        corridor.emplace_back(simplified.begin(), simplified.end());
+        trackOfPart.push_back(trackIndex);
+    }
+
+    auto streetMaps = std::vector<StreetMap>(trackList.size());
+    if (corridor.empty())
+        return streetMaps;
+
+    auto dbConnection = connection_.getConnection();
+    auto dbTransaction = pqxx::work{*dbConnection};
+
+    // Like the query of a single track, but over the parts of a multi line string (one per track), and it returns the parts near each line.
+    auto query = std::string{R"sql(
+        with track as (
+            select
+                part.path[1] - 1  part_index,
+                ST_Transform( part.geom, 32632 )  way
+            from
+                ST_Dump( ST_GeomFromText( $1, 4326 ) )  part
+        )
+        select
+            line.osm_id  line_id,
+            line.oneway  line_oneway,
+            line.highway line_highway,
+            ST_AsBinary( ST_Transform( line.way, 4326 ) )  line_way,
+            array_to_string( array( select track.part_index from track where ST_DWithin( track.way, line.way, $2 ) order by track.part_index ), ',' )  line_parts
+        from
+            planet_osm_line  line
+        where
+            ( $HIGHWAY_CONDITION )
+            and ST_DWithin( ( select ST_Collect( track.way ) from track ), line.way, $2 )
+        )sql"};
+    boost::replace_all(query, "$HIGHWAY_CONDITION", toHighwaySelectionSql(highwaySelection_, "line"));
+    auto const statement = statementName("osm_map_reader_batch_lines", highwaySelection_);
+    dbConnection->prepareOnce(statement, query);
+    pqxx::result records = dbTransaction.exec_prepared(statement, Geometry::toWkt(corridor), fetchCorridor_ + trackSimplificationDistance);
+
+    APP_LOG_TAG_MS(noise, "DB") << records.size() << " records were read for " << corridor.size() << " tracks";
+
+    auto partsOfLine = std::vector<std::vector<size_t>>{};
+    auto const lines = readLines(records, &partsOfLine);
+
+    auto linesOfTrack = std::vector<std::vector<OsmLineCandidate>>(trackList.size());
+    for (size_t lineIndex = 0; lineIndex < lines.size(); ++lineIndex)
+        for (auto const part : partsOfLine[lineIndex])
+            linesOfTrack.at(trackOfPart.at(part)).push_back(lines[lineIndex]);
+
+    for (size_t trackIndex = 0; trackIndex < trackList.size(); ++trackIndex)
+    {
+        auto [candidates, osmPointMap, uniquePoints] = getCandidates(std::move(linesOfTrack[trackIndex]), threadCount_);
+        auto & streetMap = streetMaps[trackIndex];
+        std::tie(streetMap.segmentList, streetMap.nodePairList, streetMap.travelDirectionList, streetMap.highwayList)
+            = processCandidates(candidates, osmPointMap, uniquePoints, splitOnOverlappingPoints_, threadCount_);
+    }
+
+    APP_LOG_MS(noise) << "Street maps of " << trackList.size() << " tracks created";
+
+    return streetMaps;
+}
+
 }  // namespace AppComponents::Common::Reader
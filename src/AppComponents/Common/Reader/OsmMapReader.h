@@ -20,7 +20,9 @@
 
 #include <ambpipeline/Filter.h>
 
+#include <cstddef>
 #include <unordered_set>
+#include <vector>
 
 namespace AppComponents::Common::Reader {
 
@@ -30,18 +32,37 @@ namespace AppComponents::Common::Reader {
 class OsmMapReader : public IMapReader
 {
 public:
+    /// The lists a map reader produces.
+    struct StreetMap
+    {
+        Types::Street::SegmentList segmentList;
+        Types::Street::NodePairList nodePairList;
+        Types::Street::TravelDirectionList travelDirectionList;
+        Types::Street::HighwayList highwayList;
+    };
+
+    /// @param threadCount Number of threads merging points and splitting lines, 0 to use one per hardware thread.
     OsmMapReader(
         Core::Common::Postgres::Connection & connection,
         std::unordered_set<Types::Street::HighwayType> const & highwaySelection,
         double fetchCorridor,
         bool useSingleSearchCircle,
-        bool splitOnOverlappingPoints);
+        bool splitOnOverlappingPoints,
+        size_t threadCount = 0);
 
     bool operator()(Types::Street::SegmentList &, Types::Street::NodePairList &, Types::Street::TravelDirectionList &, Types::Street::HighwayList &);
 
     bool
     operator()(Types::Track::PointList const &, Types::Street::SegmentList &, Types::Street::NodePairList &, Types::Street::TravelDirectionList &, Types::Street::HighwayList &);
 
+    /**
+     * Fetches the street maps of several tracks in one query over the union of their corridors.
+     *
+     * Each map consists of the lines within the corridor of its track, like a map fetched without `useSingleSearchCircle` for the track alone.
+     * @return The street map of each track.
+     */
+    std::vector<StreetMap> readBatch(std::vector<Types::Track::PointList> const & trackList);
+
     bool
     init(Types::Track::PointList const &, double fetchCorridor, bool useSingleSearchCircle, std::optional<std::unordered_set<Types::Street::HighwayType>> const & highwaySelection);
 
@@ -53,6 +74,7 @@ private:
     std::string pointsString_;
     bool const useSingleSearchCircle_;
     bool const splitOnOverlappingPoints_;
+    size_t const threadCount_;
 };
 
 }  // namespace AppComponents::Common::Reader
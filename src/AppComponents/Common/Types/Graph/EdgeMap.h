@@ -9,9 +9,11 @@
 
 #include <Core/Graph/Graph.h>
 
+#include <Generic/Map/DenseIdMap.h>
+
 #include <cstddef>
 #include <optional>
-#include <unordered_map>
+#include <tuple>
 
 namespace AppComponents::Common::Types::Graph {
 
@@ -29,11 +31,13 @@ struct GraphTriplePair
     std::optional<GraphTriple> backwards;
 };
 
+// Graph ids and street indices are dense, so the maps are vectors indexed by them.
+
 /// Maps graph edge to street segment.
-using GraphEdgeMap = std::unordered_map<Core::Graph::Edge, StreetEdge>;
+using GraphEdgeMap = Generic::DenseIdMap<Core::Graph::Edge, StreetEdge>;
 /// Maps street segment to graph edge
-using StreetIndexMap = std::unordered_map<size_t, GraphTriplePair>;
+using StreetIndexMap = Generic::DenseIdMap<size_t, GraphTriplePair>;
 /// Maps graph node to street junction
-using NodeMap = std::unordered_map<Core::Graph::Node, size_t>;
+using NodeMap = Generic::DenseIdMap<Core::Graph::Node, size_t>;
 
 }  // namespace AppComponents::Common::Types::Graph
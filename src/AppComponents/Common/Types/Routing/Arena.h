@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+namespace AppComponents::Common::Types::Routing {
+
+/**
+ * Memory of the routes of one match.
+ *
+ * Matching a track creates many small, short-lived routes (most of them are never chosen), which all die together.
+ * Allocating them from one monotonic buffer avoids a heap allocation per route and sub route list,
+ * releases them in one step, and avoids allocator contention when matching several tracks in parallel.
+ * A monotonic buffer only frees its memory as a whole, so a match copies the routes it returns to the heap (see `Matcher::Routing::copyToHeap`):
+ * the arena and all rejected routes are then released at the end of the match.
+ */
+using Arena = std::pmr::memory_resource;
+
+/// @return An arena for one match (a monotonic buffer, it never frees memory before it is destroyed).
+inline std::shared_ptr<Arena> makeArena()
+{
+    return std::make_shared<std::pmr::monotonic_buffer_resource>();
+}
+
+/// @return The default heap, for matches without end (f.ex. live feeds), where a monotonic buffer would grow with the track.
+inline std::shared_ptr<Arena> heapArena()
+{
+    // Non-owning, the default resource lives as long as the program.
+    return std::shared_ptr<Arena>{std::shared_ptr<Arena>{}, std::pmr::new_delete_resource()};
+}
+
+/**
+ * Allocator for `std::allocate_shared`, which keeps its arena alive.
+ *
+ * The control block of a shared object holds a copy of the allocator, so the arena is released with the last object allocated from it
+ * (keeping a single route alive keeps the whole arena).
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<Arena> arena) : arena_(std::move(arena)) {}
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const & other) : arena_(other.arena())
+    {
+    }
+
+    T * allocate(size_t const count) { return static_cast<T *>(arena_->allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T * pointer, size_t const count) { arena_->deallocate(pointer, count * sizeof(T), alignof(T)); }
+
+    std::shared_ptr<Arena> const & arena() const { return arena_; }
+
+    template <typename U>
+    bool operator==(ArenaAllocator<U> const & other) const
+    {
+        return *arena_ == *other.arena();
+    }
+    template <typename U>
+    bool operator!=(ArenaAllocator<U> const & other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    std::shared_ptr<Arena> arena_;
+};
+
+}  // namespace AppComponents::Common::Types::Routing
@@ -7,11 +7,13 @@
 
 #pragma once
 
-#include <Core/Common/Geometry/Types.h>
+#include <AppComponents/Common/Types/Routing/SubRouteGeometry.h>
+
 #include <Core/Graph/Graph.h>
 
 #include <cstddef>
 #include <memory>
+#include <memory_resource>
 #include <numeric>
 #include <optional>
 #include <utility>
@@ -26,7 +28,7 @@ struct SubRoute
 {
     Edge edge;
     double cost;
-    Core::Common::Geometry::LineString route;
+    SubRouteGeometry route;
     double length;
 };
 
@@ -54,8 +56,11 @@ struct Route
 {
     RouteNode source;
     RouteNode target;
-    std::vector<SubRoute> subRoutes;
-    Route(RouteNode const & source, RouteNode const & target, std::vector<SubRoute> const & subRoutes) : source(source), target(target), subRoutes(subRoutes) {}
+    std::pmr::vector<SubRoute> subRoutes;  ///< Allocated from the arena of the route, see `Arena`.
+    Route(RouteNode const & source, RouteNode const & target, std::pmr::polymorphic_allocator<SubRoute> const allocator = {})
+      : source(source), target(target), subRoutes(allocator)
+    {
+    }
     double cost() const
     {
         if (!cost_)
@@ -41,4 +41,16 @@ struct SamplingPoint
 
 using SamplingPointList = std::vector<SamplingPoint>;
 
+/**
+ * Cumulative approximate distance along the sampling points, indexed by sampling point index.
+ *
+ * The distance between two sampling points is the difference of their entries.
+ */
+using SamplingPointDistanceList = std::vector<double>;
+
+/**
+ * Approximate location (the projected point of the first candidate) of each sampling point, indexed by sampling point index.
+ */
+using SamplingPointLocationList = std::vector<Core::Common::Geometry::Point>;
+
 }  // namespace AppComponents::Common::Types::Routing
@@ -9,8 +9,10 @@
 
 #include <AppComponents/Common/Matcher/Routing/Types.h>
 
-#include <unordered_map>
-#include <unordered_set>
+#include <Generic/Map/FlatHashMap.h>
+
+#include <utility>
+#include <vector>
 
 namespace AppComponents::Common::Types::Routing {
 
@@ -27,7 +29,7 @@ struct CalculatedRouteStatistic
  */
 struct RoutingStatistic
 {
-    std::unordered_map<Matcher::Routing::SamplingPointsSelection, CalculatedRouteStatistic> calculated;
+    Generic::FlatHashMap<Matcher::Routing::SamplingPointsSelection, CalculatedRouteStatistic> calculated;
     std::vector<std::pair<Matcher::Routing::SamplingPointsSelection, bool>> visited;
 };
 
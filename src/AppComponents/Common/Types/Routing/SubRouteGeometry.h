@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <Core/Common/Geometry/Types.h>
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+
+namespace AppComponents::Common::Types::Routing {
+
+/**
+ * Geometry of a sub route, referencing a point range of a street segment instead of copying it.
+ *
+ * The points are an optional `head`, followed by `numPoints` points of the street geometry starting at `firstPoint`
+ * (walking forwards or backwards), followed by an optional `tail`.
+ * Consecutive duplicate points (f.ex. a projected point lying exactly on a street point) are skipped on iteration.
+ *
+ * The referenced street geometry must outlive this object.
+ */
+class SubRouteGeometry
+{
+public:
+    using Point = Core::Common::Geometry::Point;
+    using LineString = Core::Common::Geometry::LineString;
+
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Point;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Point const *;
+        using reference = Point const &;
+
+        const_iterator() = default;
+        const_iterator(SubRouteGeometry const * geometry, size_t position) : geometry_(geometry), position_(position) {}
+
+        reference operator*() const { return geometry_->rawPoint(position_); }
+        pointer operator->() const { return &geometry_->rawPoint(position_); }
+
+        const_iterator & operator++()
+        {
+            position_ = geometry_->nextPosition(position_);
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            auto result = *this;
+            ++(*this);
+            return result;
+        }
+
+        bool operator==(const_iterator const & other) const { return position_ == other.position_; }
+        bool operator!=(const_iterator const & other) const { return position_ != other.position_; }
+
+    private:
+        SubRouteGeometry const * geometry_{nullptr};
+        size_t position_{0};
+    };
+
+    SubRouteGeometry(
+        LineString const & streetGeometry,
+        size_t const firstPoint,
+        size_t const numPoints,
+        bool const forwards,
+        std::optional<Point> const & head = std::nullopt,
+        std::optional<Point> const & tail = std::nullopt)
+      : streetGeometry_(&streetGeometry), firstPoint_(firstPoint), numPoints_(numPoints), forwards_(forwards), head_(head), tail_(tail), size_(countPoints())
+    {
+        assert(numPoints_ == 0 || (forwards_ ? firstPoint_ + numPoints_ <= streetGeometry_->size() : firstPoint_ + 1 >= numPoints_));
+    }
+
+    /// Number of points without consecutive duplicates.
+    size_t size() const { return size_; }
+    bool empty() const { return rawSize() == 0; }
+
+    const_iterator begin() const { return const_iterator{this, 0}; }
+    const_iterator end() const { return const_iterator{this, rawSize()}; }
+
+    Point const & front() const { return rawPoint(0); }
+    Point const & back() const { return rawPoint(rawSize() - 1); }
+
+    /// Copies the referenced points.
+    LineString toLineString() const
+    {
+        LineString lineString;
+        lineString.reserve(size());
+        for (auto const & point : *this)
+            lineString.push_back(point);
+        return lineString;
+    }
+
+private:
+    size_t rawSize() const { return (head_ ? 1 : 0) + numPoints_ + (tail_ ? 1 : 0); }
+
+    Point const & rawPoint(size_t position) const
+    {
+        if (head_)
+        {
+            if (position == 0)
+                return *head_;
+            --position;
+        }
+        if (position < numPoints_)
+            return (*streetGeometry_)[forwards_ ? firstPoint_ + position : firstPoint_ - position];
+        return *tail_;
+    }
+
+    /// Counted once on construction, so routes can be read from several threads.
+    size_t countPoints() const
+    {
+        size_t count = 0;
+        for (size_t position = 0; position < rawSize(); position = nextPosition(position))
+            ++count;
+        return count;
+    }
+
+    size_t nextPosition(size_t position) const
+    {
+        auto const & point = rawPoint(position);
+        for (++position; position < rawSize(); ++position)
+            if (!(rawPoint(position) == point))
+                break;
+        return position;
+    }
+
+    LineString const * streetGeometry_;
+    size_t firstPoint_;
+    size_t numPoints_;
+    bool forwards_;
+    std::optional<Point> head_;
+    std::optional<Point> tail_;
+    size_t const size_;
+};
+
+}  // namespace AppComponents::Common::Types::Routing
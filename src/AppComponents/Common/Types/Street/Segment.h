@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <Core/Common/Geometry/PackedLineStrings.h>
 #include <Core/Common/Geometry/Types.h>
 
 #include <vector>
@@ -25,4 +26,27 @@ struct Segment
 
 using SegmentList = std::vector<Segment>;
 
+/// Geo length of each segment of a `SegmentList`, indexed by street index.
+using SegmentLengthList = std::vector<double>;
+
+/**
+ * Compact fixed-point (E7) copy of the geometries of a `SegmentList`, indexed by street index.
+ *
+ * Optional: the candidate search and the map writer read the geometries through its views if they are given one.
+ * For maps with at most 7 decimal places (like OSM data) the results do not change, other maps are rounded to about 1 cm.
+ */
+using SegmentGeometryList = Core::Common::Geometry::PackedLineStringList;
+
+inline SegmentGeometryList toSegmentGeometryList(SegmentList const & segmentList)
+{
+    size_t numPoints = 0;
+    for (auto const & segment : segmentList)
+        numPoints += segment.geometry.size();
+    SegmentGeometryList segmentGeometryList;
+    segmentGeometryList.reserve(segmentList.size(), numPoints);
+    for (auto const & segment : segmentList)
+        segmentGeometryList.push_back(segment.geometry);
+    return segmentGeometryList;
+}
+
 }  // namespace AppComponents::Common::Types::Street
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <sstream>
 #include <fstream>
+#include <iterator>
 
 namespace AppComponents::Common::Writer {
 
@@ -34,21 +35,28 @@ bool CsvRouteWriter::operator()(
     output
         << "osm_ids;route;length;cost;sourceNode;targetNode;sourceSamplingPointTime;targetSamplingPointTime;sourceSamplingPointCandidateIndex;targetSamplingPointCandidateIndex;sourceSamplingPointCandidateConsideredForwards;targetSamplingPointCandidateConsideredForwards;routeStartPoint;routeEndPoint\n";
     output << std::setprecision(14);
+    std::vector<Core::Common::Geometry::Point> points;
+    std::string wkt;
+    auto writeWkt = [&](auto const & geometry, char const separator)
+    {
+        wkt.clear();
+        Core::Common::Geometry::appendWkt(wkt, geometry);
+        output << wkt << separator;
+    };
     for (auto const & route : routeList)
     {
         auto const & source = route->source;
         auto const & target = route->target;
         auto const & subRoutes = route->subRoutes;
-        std::vector<Core::Common::Geometry::Point> points;
+        points.clear();
         std::vector<size_t> osmIds;
         double totalCost = 0.0;
         double totalLength = 0.0;
         for (auto const & [edge, cost, route, length] : subRoutes)
         {
             auto streetEdge = graphEdgeMap.at(edge);
-            auto segment = segmentList[streetEdge.streetIndex];
-            for (size_t i = points.empty() ? 0 : 1; i < route.size(); ++i)
-                points.push_back(route[i]);
+            auto const & segment = segmentList[streetEdge.streetIndex];
+            points.insert(points.end(), std::next(route.begin(), points.empty() ? 0 : 1), route.end());
             if (osmIds.empty() || osmIds.back() != segment.originId)
                 osmIds.push_back(segment.originId);
             totalCost += cost;
@@ -61,7 +69,7 @@ bool CsvRouteWriter::operator()(
             str.resize(str.length() - 1);
             output << str << ';';
         }
-        output << Core::Common::Geometry::toWkt(points) << ';';
+        writeWkt(points, ';');
         output << totalLength << ';';
         output << totalCost << ';';
         output << nodeMap.at(source.node) << ';';
@@ -72,8 +80,8 @@ bool CsvRouteWriter::operator()(
         output << target.samplingPoint.candidate.index << ';';
         output << source.samplingPoint.candidate.consideredForwards << ';';
         output << target.samplingPoint.candidate.consideredForwards << ';';
-        output << Core::Common::Geometry::toWkt(points[0]) << ';';
-        output << Core::Common::Geometry::toWkt(points[points.size() - 1]) << '\n';
+        writeWkt(points[0], ';');
+        writeWkt(points[points.size() - 1], '\n');
     }
 
     return true;
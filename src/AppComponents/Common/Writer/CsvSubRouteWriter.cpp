@@ -31,6 +31,8 @@ bool CsvSubRouteWriter::operator()(
     output
         << "osm_id;route;length;cost;sourceNode;targetNode;sourceSamplingPointTime;targetSamplingPointTime;sourceSamplingPointCandidateIndex;targetSamplingPointCandidateIndex;sourceSamplingPointCandidateConsideredForwards;targetSamplingPointCandidateConsideredForwards\n";
     output << std::setprecision(14);
+    std::vector<Core::Common::Geometry::Point> points;
+    std::string wkt;
     for (auto const & route : routeList)
     {
         auto const & source = route->source;
@@ -39,11 +41,12 @@ bool CsvSubRouteWriter::operator()(
         for (auto const & [edge, cost, route, length] : subRoutes)
         {
             auto streetEdge = graphEdgeMap.at(edge);
-            auto segment = segmentList[streetEdge.streetIndex];
-            std::vector<Core::Common::Geometry::Point> points;
-            std::transform(route.begin(), route.end(), std::back_inserter(points), [](const auto point) { return point; });
+            auto const & segment = segmentList[streetEdge.streetIndex];
+            points.assign(route.begin(), route.end());
+            wkt.clear();
+            Core::Common::Geometry::appendWkt(wkt, points);
             output << segment.originId << ';';
-            output << Core::Common::Geometry::toWkt(points) << ';';
+            output << wkt << ';';
             output << length << ';';
             output << cost << ';';
             output << nodeMap.at(source.node) << ';';
@@ -54,7 +54,8 @@ namespace {
 
 }  // namespace
 
-GeoJsonMapWriter::GeoJsonMapWriter(std::ostream & output) : output_(output)
+GeoJsonMapWriter::GeoJsonMapWriter(std::ostream & output, Types::Street::SegmentGeometryList const * const segmentGeometryList)
+  : output_(output), segmentGeometryList_(segmentGeometryList)
 {
 }
 
@@ -69,6 +70,7 @@ bool GeoJsonMapWriter::operator()(
 
     assert(segmentList.size() == nodePairList.size());
     assert(segmentList.size() == travelDirectionList.size());
+    assert(!segmentGeometryList_ || segmentList.size() == segmentGeometryList_->size());
 
     output << R"RAW({ "type": "FeatureCollection", "features": [)RAW" << '\n';
 
@@ -83,7 +85,7 @@ bool GeoJsonMapWriter::operator()(
         //features.push_back( nlohmann::json{
         output << nlohmann::json{
             {"type", "Feature"},
-            {"geometry", Core::Common::Geometry::toGeoJson(segment.geometry)},
+            {"geometry", segmentGeometryList_ ? Core::Common::Geometry::toGeoJson((*segmentGeometryList_)[i]) : Core::Common::Geometry::toGeoJson(segment.geometry)},
             {"properties",
              nlohmann::json{
                  {"Id", segment.originId},
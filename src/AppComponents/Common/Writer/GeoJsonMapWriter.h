@@ -22,7 +22,8 @@ namespace AppComponents::Common::Writer {
 class GeoJsonMapWriter : public IMapWriter
 {
 public:
-    GeoJsonMapWriter(std::ostream & output);
+    /// @param segmentGeometryList Written instead of the geometries of the segment list if given.
+    GeoJsonMapWriter(std::ostream & output, Types::Street::SegmentGeometryList const * segmentGeometryList = nullptr);
 
     bool operator()(
         std::ostream &,
@@ -41,6 +42,7 @@ public:
 
 private:
     std::ostream & output_;
+    Types::Street::SegmentGeometryList const * const segmentGeometryList_;
 };
 
 }  // namespace AppComponents::Common::Writer
@@ -36,7 +36,7 @@ bool GeoJsonRouteWriter::operator()(
         for (auto const & subRoute : route->subRoutes)
         {
             auto streetEdge = graphEdgeMap.at(subRoute.edge);
-            auto segment = segmentList[streetEdge.streetIndex];
+            auto const & segment = segmentList[streetEdge.streetIndex];
 
             assert(!subRoute.route.empty());
             if (subRoute.route.size() == 1)
@@ -47,7 +47,7 @@ bool GeoJsonRouteWriter::operator()(
 
             output << nlohmann::json{
                 {"type", "Feature"},
-                {"geometry", Core::Common::Geometry::toGeoJson(subRoute.route)},
+                {"geometry", Core::Common::Geometry::toGeoJson(subRoute.route.toLineString())},
                 {"properties",
                  nlohmann::json{
                      {"Id", segment.originId},
@@ -0,0 +1,59 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <Core/Common/File/MappedFile.h>
+
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Core::Common::File {
+
+MappedFile::MappedFile(std::string const & fileName)
+{
+    auto const fileDescriptor = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fileDescriptor < 0)
+        throw std::system_error(errno, std::generic_category(), "cannot open " + fileName);
+
+    struct stat status = {};
+    if (::fstat(fileDescriptor, &status) != 0)
+    {
+        auto const error = errno;
+        ::close(fileDescriptor);
+        throw std::system_error(error, std::generic_category(), "cannot stat " + fileName);
+    }
+
+    // Empty files cannot be mapped, they just have no content.
+    size_ = static_cast<size_t>(status.st_size);
+    if (size_ != 0)
+    {
+        auto * const data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if (data == MAP_FAILED)
+        {
+            auto const error = errno;
+            ::close(fileDescriptor);
+            throw std::system_error(error, std::generic_category(), "cannot map " + fileName);
+        }
+        // The file is read front to back.
+        ::madvise(data, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<char const *>(data);
+    }
+
+    // The mapping stays valid without the file descriptor.
+    ::close(fileDescriptor);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr)
+        ::munmap(const_cast<char *>(data_), size_);
+}
+
+}  // namespace Core::Common::File
@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace Core::Common::File {
+
+/**
+ * Read-only memory mapping of a whole file.
+ *
+ * The content is paged in by the operating system on access, so reading it neither copies it nor allocates.
+ * @throws std::system_error If the file cannot be opened or mapped.
+ */
+class MappedFile
+{
+public:
+    explicit MappedFile(std::string const & fileName);
+    ~MappedFile();
+
+    MappedFile(MappedFile const &) = delete;
+    MappedFile & operator=(MappedFile const &) = delete;
+
+    /// Valid as long as the mapping exists.
+    std::string_view content() const { return {data_, size_}; }
+
+private:
+    char const * data_{nullptr};
+    size_t size_{0};
+};
+
+}  // namespace Core::Common::File
@@ -6,12 +6,203 @@
 
 #include <Core/Common/Geometry/Conversion.h>
 
-#include <Generic/String/Split.h>
+#include <Generic/String/Number.h>
 
-#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
 
 namespace Core::Common::Geometry {
 
+namespace {
+
+    constexpr int wktPrecision = 14;
+
+    void appendCoordinates(std::string & buffer, Point const & point)
+    {
+        Generic::String::appendDouble(buffer, point.lon(), wktPrecision);
+        buffer += ' ';
+        Generic::String::appendDouble(buffer, point.lat(), wktPrecision);
+    }
+
+    template <typename Iterator>
+    void appendPoints(std::string & buffer, Iterator begin, Iterator const end)
+    {
+        buffer += '(';
+        for (auto first = true; begin != end; ++begin, first = false)
+        {
+            if (!first)
+                buffer += ',';
+            appendCoordinates(buffer, *begin);
+        }
+        buffer += ')';
+    }
+
+    /// Reads WKT in place, f.ex. `LINESTRING(13.3777 52.5163,13.3801 52.5171)`.
+    class WktParser
+    {
+    public:
+        /// Consumes the tag.
+        WktParser(std::string_view const wkt, std::string_view const tag) : wkt_(wkt), tag_(tag)
+        {
+            skipWhitespace();
+            if (!consumeWord(tag))
+                fail();
+            // The dimensions, the coordinates tell them anyway.
+            skipWhitespace();
+            consumeWord("ZM") || consumeWord("Z") || consumeWord("M");
+        }
+
+        [[noreturn]] void fail() const { throw std::domain_error("String is not a " + std::string{tag_} + '.'); }
+
+        /**
+         * Consumes the opening parenthesis of a list.
+         * @return False if the list is empty (`()`, which `toWkt` writes for empty geometries, or `EMPTY`).
+         */
+        bool listBegins()
+        {
+            skipWhitespace();
+            if (consumeWord("EMPTY"))
+                return false;
+            expect('(');
+            skipWhitespace();
+            return !consume(')');
+        }
+
+        /// Consumes a separator or the closing parenthesis of a list.
+        bool listContinues()
+        {
+            skipWhitespace();
+            if (consume(','))
+                return true;
+            expect(')');
+            return false;
+        }
+
+        Point point()
+        {
+            auto const lon = number();
+            auto const lat = number();
+            // Z and M coordinates.
+            for (skipWhitespace(); !wkt_.empty() && wkt_.front() != ',' && wkt_.front() != ')'; skipWhitespace())
+                number();
+            return Point{Point::Longitude{lon}, Point::Latitude{lat}};
+        }
+
+        LineString lineString()
+        {
+            auto points = LineString{};
+            if (!listBegins())
+                return points;
+            // Points are separated by commas, which is an upper bound for a nested list.
+            points.reserve(static_cast<size_t>(std::count(wkt_.begin(), std::find(wkt_.begin(), wkt_.end(), ')'), ',')) + 1);
+            do
+                points.push_back(point());
+            while (listContinues());
+            return points;
+        }
+
+        void finish()
+        {
+            skipWhitespace();
+            if (!wkt_.empty())
+                fail();
+        }
+
+    private:
+        void skipWhitespace()
+        {
+            while (!wkt_.empty() && std::isspace(static_cast<unsigned char>(wkt_.front())))
+                wkt_.remove_prefix(1);
+        }
+
+        bool consume(char const c)
+        {
+            if (wkt_.empty() || wkt_.front() != c)
+                return false;
+            wkt_.remove_prefix(1);
+            return true;
+        }
+
+        void expect(char const c)
+        {
+            if (!consume(c))
+                fail();
+        }
+
+        bool consumeWord(std::string_view const word)
+        {
+            auto const matches = wkt_.size() >= word.size()
+                && std::equal(word.begin(), word.end(), wkt_.begin(), [](char const a, char const b) { return a == std::toupper(static_cast<unsigned char>(b)); });
+            if (matches)
+                wkt_.remove_prefix(word.size());
+            return matches;
+        }
+
+        double number()
+        {
+            skipWhitespace();
+            double value;
+            auto const length = Generic::String::parseDouble(wkt_, value);
+            if (length == 0)
+                fail();
+            wkt_.remove_prefix(length);
+            return value;
+        }
+
+        std::string_view wkt_;
+        std::string_view const tag_;
+    };
+
+    /// Reads the values of well-known binary in place.
+    class WkbReader
+    {
+    public:
+        explicit WkbReader(std::basic_string_view<std::byte> const wkb) : wkb_(wkb) {}
+
+        size_t remaining() const { return wkb_.size(); }
+
+        void readByteOrder()
+        {
+            auto const byteOrder = read<std::uint8_t>();
+            if (byteOrder > 1)
+                throw std::domain_error("WKB has an invalid byte order.");
+            // 1 is little endian (NDR), 0 is big endian (XDR).
+            swap_ = (byteOrder == 1) != isLittleEndian();
+        }
+
+        template <typename T>
+        T read()
+        {
+            if (wkb_.size() < sizeof(T))
+                throw std::domain_error("WKB is truncated.");
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, wkb_.data(), sizeof(T));
+            wkb_.remove_prefix(sizeof(T));
+            if (swap_)
+                std::reverse(std::begin(bytes), std::end(bytes));
+            T value;
+            std::memcpy(&value, bytes, sizeof(T));
+            return value;
+        }
+
+    private:
+        static bool isLittleEndian()
+        {
+            std::uint16_t const value = 1;
+            unsigned char firstByte;
+            std::memcpy(&firstByte, &value, 1);
+            return firstByte == 1;
+        }
+
+        std::basic_string_view<std::byte> wkb_;
+        bool swap_{false};
+    };
+
+}  // namespace
+
 nlohmann::json toGeoJson(LineString const & lineString)
 {
     nlohmann::json array = nlohmann::json::array();
@@ -28,105 +219,153 @@ nlohmann::json toGeoJson(Point const & point)
     return nlohmann::json{{"type", "Point"}, {"coordinates", nlohmann::json::array({point.lon(), point.lat()})}};
 }
 
+nlohmann::json toGeoJson(PackedLineStringView const & lineString)
+{
+    nlohmann::json array = nlohmann::json::array();
+    for (auto const point : lineString)
+        array.push_back(nlohmann::json::array({point.lon(), point.lat()}));
+    return nlohmann::json{{"type", "LineString"}, {"coordinates", array}};
+}
+
 LineString toLineString(nlohmann::json const & geoJson)
 {
     if (geoJson.at("type").get<std::string>() != "LineString")
-        throw std::runtime_error("GeoJson type is not LineString");
+        throw std::domain_error("GeoJson type is not LineString");
+    auto const & coordinates = geoJson.at("coordinates");
     LineString lineString;
-    for (auto const & coordinate : geoJson.at("coordinates"))
+    lineString.reserve(coordinates.size());
+    for (auto const & coordinate : coordinates)
         lineString.push_back(Point{Point::Longitude{coordinate.at(0).get<double>()}, Point::Latitude{coordinate.at(1).get<double>()}});
     return lineString;
 }
 
 std::string toWkt(Point const & point)
 {
-    std::ostringstream oss;
-    oss << std::setprecision(14);
-    oss << "POINT(";
-    oss << point.lon() << ' ' << point.lat();
-    oss << ')';
-    return oss.str();
+    auto wkt = std::string{};
+    appendWkt(wkt, point);
+    return wkt;
 }
 
 std::string toWkt(std::vector<Point> const & points)
 {
-    std::ostringstream oss;
-    oss << std::setprecision(14);
-    oss << "LINESTRING(";
-    for (size_t i = 0; i < points.size(); ++i)
-    {
-        auto const & point = points[i];
-        oss << point.lon() << ' ' << point.lat();
-        if (i < points.size() - 1)
-            oss << ',';
-    }
-    oss << ')';
-    return oss.str();
+    auto wkt = std::string{};
+    appendWkt(wkt, points);
+    return wkt;
 }
 
 std::string toWkt(std::vector<std::vector<Point>> const & points)
 {
-    std::ostringstream oss;
-    oss << std::setprecision(14);
-    oss << "MULTILINESTRING(";
+    auto wkt = std::string{};
+    appendWkt(wkt, points);
+    return wkt;
+}
+
+std::string toWkt(PackedLineStringView const & lineString)
+{
+    auto wkt = std::string{};
+    appendWkt(wkt, lineString);
+    return wkt;
+}
+
+void appendWkt(std::string & buffer, Point const & point)
+{
+    buffer += "POINT(";
+    appendCoordinates(buffer, point);
+    buffer += ')';
+}
+
+void appendWkt(std::string & buffer, std::vector<Point> const & points)
+{
+    buffer += "LINESTRING";
+    appendPoints(buffer, points.begin(), points.end());
+}
+
+void appendWkt(std::string & buffer, PackedLineStringView const & lineString)
+{
+    buffer += "LINESTRING";
+    appendPoints(buffer, lineString.begin(), lineString.end());
+}
+
+void appendWkt(std::string & buffer, std::vector<std::vector<Point>> const & points)
+{
+    buffer += "MULTILINESTRING(";
     for (size_t i = 0; i < points.size(); ++i)
     {
-        oss << "(";
-        for (size_t j = 0; j < points[i].size(); ++j)
-        {
-            auto const & point = points[i][j];
-            oss << point.lon() << ' ' << point.lat();
-            if (j < points[i].size() - 1)
-                oss << ',';
-        }
-        oss << ')';
-        if (i < points.size() - 1)
-            oss << ',';
+        if (i > 0)
+            buffer += ',';
+        appendPoints(buffer, points[i].begin(), points[i].end());
     }
-    oss << ')';
-    return oss.str();
+    buffer += ')';
 }
 
-LineString toLineString(std::string const & wkt)
+LineString toLineString(std::string_view const wkt)
 {
-    size_t coordinatesOffset = 0;
-    if (wkt.substr(0, 11) == "LINESTRING(")
-        coordinatesOffset = 11;
-    else if (wkt.substr(0, 12) == "LINESTRING (")
-        coordinatesOffset = 12;
-    else
-        throw std::domain_error("String is not a LINESTRING.");
-    if (wkt.substr(wkt.size() - 1, 1) != ")")
-        throw std::domain_error("String is not a LINESTRING.");
-    std::vector<std::string> pointsString;
-    Generic::String::split(wkt.substr(coordinatesOffset, wkt.size() - coordinatesOffset - 1), ',', std::back_inserter(pointsString));
-    LineString points;
-    Point point;
-    double x;
-    for (auto const & pointString : pointsString)
-    {
-        std::istringstream iss(pointString);
-        iss >> x;
-        point.setLon(x);
-        iss >> x;
-        point.setLat(x);
-        points.push_back(point);
-    }
+    auto parser = WktParser{wkt, "LINESTRING"};
+    auto points = parser.lineString();
+    parser.finish();
     return points;
 }
 
-Point toPoint(std::string const & wkt)
+LineString toLineString(std::string const & wkt)
+{
+    return toLineString(std::string_view{wkt});
+}
+
+std::vector<LineString> toMultiLineString(std::string_view const wkt)
 {
-    if (wkt.substr(0, 6) != "POINT(" || wkt.substr(wkt.size() - 1, 1) != ")")
-        throw std::domain_error("String is not a POINT.");
-    Point point;
-    double x;
-    std::istringstream iss(wkt.substr(11, wkt.size() - 11 - 1));
-    iss >> x;
-    point.setLat(x);
-    iss >> x;
-    point.setLon(x);
+    auto parser = WktParser{wkt, "MULTILINESTRING"};
+    auto lineStrings = std::vector<LineString>{};
+    if (parser.listBegins())
+        do
+            lineStrings.push_back(parser.lineString());
+        while (parser.listContinues());
+    parser.finish();
+    return lineStrings;
+}
+
+Point toPoint(std::string_view const wkt)
+{
+    auto parser = WktParser{wkt, "POINT"};
+    if (!parser.listBegins())
+        parser.fail();
+    auto const point = parser.point();
+    if (parser.listContinues())
+        parser.fail();
+    parser.finish();
     return point;
 }
 
+LineString wkbToLineString(std::basic_string_view<std::byte> const wkb)
+{
+    auto reader = WkbReader{wkb};
+    reader.readByteOrder();
+
+    // ISO WKB encodes the dimensions in the thousands (1002 is LINESTRING Z), EWKB in the high bits, which also flag an SRID.
+    auto const type = reader.read<std::uint32_t>();
+    auto const isoType = type & 0x0fffffffu;
+    if (isoType % 1000 != 2)
+        throw std::domain_error("WKB is not a LINESTRING.");
+    auto const hasZ = (type & 0x80000000u) != 0 || isoType / 1000 == 1 || isoType / 1000 == 3;
+    auto const hasM = (type & 0x40000000u) != 0 || isoType / 1000 == 2 || isoType / 1000 == 3;
+    if ((type & 0x20000000u) != 0)
+        reader.read<std::uint32_t>();
+    auto const skippedCoordinates = size_t{hasZ} + size_t{hasM};
+
+    auto const numPoints = reader.read<std::uint32_t>();
+    if (reader.remaining() < size_t{numPoints} * (2 + skippedCoordinates) * sizeof(double))
+        throw std::domain_error("WKB is truncated.");
+
+    LineString points;
+    points.reserve(numPoints);
+    for (std::uint32_t i = 0; i < numPoints; ++i)
+    {
+        auto const x = reader.read<double>();
+        auto const y = reader.read<double>();
+        for (size_t j = 0; j < skippedCoordinates; ++j)
+            reader.read<double>();
+        points.push_back(Point{Point::Longitude{x}, Point::Latitude{y}});
+    }
+    return points;
+}
+
 }  // namespace Core::Common::Geometry
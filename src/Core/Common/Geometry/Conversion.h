@@ -6,23 +6,52 @@
 
 #pragma once
 
+#include <Core/Common/Geometry/PackedLineStrings.h>
 #include <Core/Common/Geometry/Types.h>
 
 #include <nlohmann/json.hpp>
 
+#include <cstddef>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace Core::Common::Geometry {
 
 nlohmann::json toGeoJson(LineString const & lineString);
 nlohmann::json toGeoJson(Point const & point);
+nlohmann::json toGeoJson(PackedLineStringView const & lineString);
 
+/// @throws std::domain_error If the GeoJSON geometry is no `LineString`, nlohmann::json::exception if its members are missing or of the wrong type.
 LineString toLineString(nlohmann::json const & geoJson);
 
+/// Coordinates are written with 14 significant digits.
 std::string toWkt(Point const & point);
 std::string toWkt(std::vector<Point> const & points);
 std::string toWkt(std::vector<std::vector<Point>> const & points);
+std::string toWkt(PackedLineStringView const & lineString);
+
+/// Like `toWkt`, but appends to \p buffer, so a buffer reused for many geometries does not allocate.
+void appendWkt(std::string & buffer, Point const & point);
+void appendWkt(std::string & buffer, std::vector<Point> const & points);
+void appendWkt(std::string & buffer, std::vector<std::vector<Point>> const & points);
+void appendWkt(std::string & buffer, PackedLineStringView const & lineString);
+
+/**
+ * WKT parsers, the tags are case-insensitive and may be followed by whitespace. Z and M coordinates are skipped.
+ * @throws std::domain_error If the text is no geometry of the type.
+ */
+LineString toLineString(std::string_view wkt);
 LineString toLineString(std::string const & wkt);
-Point toPoint(std::string const & wkt);
+std::vector<LineString> toMultiLineString(std::string_view wkt);
+Point toPoint(std::string_view wkt);
+
+/**
+ * Decodes a LINESTRING from well-known binary (f.ex. from `ST_AsBinary` or `ST_AsEWKB`), either byte order.
+ *
+ * Z and M coordinates are skipped.
+ * @throws std::domain_error If the data is no (complete) LINESTRING.
+ */
+LineString wkbToLineString(std::basic_string_view<std::byte> wkb);
 
 }  // namespace Core::Common::Geometry
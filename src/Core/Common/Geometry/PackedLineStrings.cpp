@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <Core/Common/Geometry/PackedLineStrings.h>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace Core::Common::Geometry {
+
+PackedPoint pack(Point const & point)
+{
+    return PackedPoint{static_cast<std::int32_t>(std::lround(point.lon() * packedPointScale)), static_cast<std::int32_t>(std::lround(point.lat() * packedPointScale))};
+}
+
+Point unpack(PackedPoint const & point)
+{
+    return Point{Point::Longitude{point.lon / packedPointScale}, Point::Latitude{point.lat / packedPointScale}};
+}
+
+LineString PackedLineStringView::toLineString() const
+{
+    LineString lineString;
+    lineString.reserve(size());
+    for (auto it = begin_; it != end_; ++it)
+        lineString.push_back(unpack(*it));
+    return lineString;
+}
+
+PackedLineStringList::PackedLineStringList() : offsets_{0}
+{
+}
+
+void PackedLineStringList::reserve(size_t const numLineStrings, size_t const numPoints)
+{
+    offsets_.reserve(numLineStrings + 1);
+    points_.reserve(numPoints);
+}
+
+size_t PackedLineStringList::push_back(LineString const & lineString)
+{
+    for (auto const & point : lineString)
+        points_.push_back(pack(point));
+    offsets_.push_back(points_.size());
+    return offsets_.size() - 2;
+}
+
+size_t PackedLineStringList::size() const
+{
+    return offsets_.size() - 1;
+}
+
+bool PackedLineStringList::empty() const
+{
+    return size() == 0;
+}
+
+size_t PackedLineStringList::numPoints() const
+{
+    return points_.size();
+}
+
+PackedLineStringView PackedLineStringList::operator[](size_t const index) const
+{
+    return PackedLineStringView{points_.data() + offsets_[index], points_.data() + offsets_[index + 1]};
+}
+
+PackedLineStringView PackedLineStringList::at(size_t const index) const
+{
+    if (index >= size())
+        throw std::out_of_range("Line string index out of range.");
+    return (*this)[index];
+}
+
+}  // namespace Core::Common::Geometry
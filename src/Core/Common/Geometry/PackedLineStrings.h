@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <Core/Common/Geometry/Types.h>
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace Core::Common::Geometry {
+
+/**
+ * Fixed-point coordinate in units of 1e-7 degree (E7), which is about 1.1 cm at the equator.
+ */
+struct PackedPoint
+{
+    std::int32_t lon;
+    std::int32_t lat;
+};
+
+inline bool operator==(PackedPoint const & a, PackedPoint const & b)
+{
+    return a.lon == b.lon && a.lat == b.lat;
+}
+
+/// Number of fixed-point units per degree.
+constexpr double packedPointScale = 1e7;
+
+PackedPoint pack(Point const & point);
+Point unpack(PackedPoint const & point);
+
+/**
+ * Non-owning view onto one line string of a `PackedLineStringList`.
+ *
+ * Points are unpacked on access, so iterating yields `Point`s by value.
+ * The view stays valid as long as the list is not modified.
+ */
+class PackedLineStringView
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Point;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Point;
+
+        const_iterator() = default;
+        explicit const_iterator(PackedPoint const * position) : position_(position) {}
+
+        Point operator*() const { return unpack(*position_); }
+        Point operator[](difference_type n) const { return unpack(position_[n]); }
+
+        const_iterator & operator++()
+        {
+            ++position_;
+            return *this;
+        }
+        const_iterator operator++(int) { return const_iterator{position_++}; }
+        const_iterator & operator--()
+        {
+            --position_;
+            return *this;
+        }
+        const_iterator operator--(int) { return const_iterator{position_--}; }
+        const_iterator & operator+=(difference_type n)
+        {
+            position_ += n;
+            return *this;
+        }
+        const_iterator & operator-=(difference_type n)
+        {
+            position_ -= n;
+            return *this;
+        }
+        const_iterator operator+(difference_type n) const { return const_iterator{position_ + n}; }
+        const_iterator operator-(difference_type n) const { return const_iterator{position_ - n}; }
+        difference_type operator-(const_iterator const & other) const { return position_ - other.position_; }
+
+        bool operator==(const_iterator const & other) const { return position_ == other.position_; }
+        bool operator!=(const_iterator const & other) const { return position_ != other.position_; }
+        bool operator<(const_iterator const & other) const { return position_ < other.position_; }
+
+    private:
+        PackedPoint const * position_{nullptr};
+    };
+
+    PackedLineStringView() = default;
+    PackedLineStringView(PackedPoint const * begin, PackedPoint const * end) : begin_(begin), end_(end) {}
+
+    size_t size() const { return static_cast<size_t>(end_ - begin_); }
+    bool empty() const { return begin_ == end_; }
+
+    Point operator[](size_t index) const { return unpack(begin_[index]); }
+    Point front() const { return unpack(*begin_); }
+    Point back() const { return unpack(*(end_ - 1)); }
+
+    const_iterator begin() const { return const_iterator{begin_}; }
+    const_iterator end() const { return const_iterator{end_}; }
+
+    /// Raw fixed-point data.
+    PackedPoint const * data() const { return begin_; }
+
+    LineString toLineString() const;
+
+private:
+    PackedPoint const * begin_{nullptr};
+    PackedPoint const * end_{nullptr};
+};
+
+/**
+ * Stores many line strings in one contiguous buffer of fixed-point coordinates.
+ *
+ * Compared to a `std::vector<LineString>` this needs less than half of the memory
+ * (8 instead of 16 bytes per point and no per-line-string heap allocation)
+ * and line strings stored one after another are adjacent in memory.
+ */
+class PackedLineStringList
+{
+public:
+    PackedLineStringList();
+
+    void reserve(size_t numLineStrings, size_t numPoints);
+
+    /// Appends a line string and returns its index.
+    size_t push_back(LineString const & lineString);
+
+    size_t size() const;
+    bool empty() const;
+
+    /// Total number of points of all line strings.
+    size_t numPoints() const;
+
+    PackedLineStringView operator[](size_t index) const;
+    PackedLineStringView at(size_t index) const;
+
+private:
+    std::vector<PackedPoint> points_;
+    std::vector<size_t> offsets_;  ///< Start of each line string in `points_`, followed by the end of the last one.
+};
+
+}  // namespace Core::Common::Geometry
@@ -1,4 +1,3 @@
-
 /*
  * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
  *
@@ -7,14 +6,47 @@
 
 #pragma once
 
+#include <Generic/Pool/Pool.h>
+
 #include <pqxx/pqxx>
 
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace Core::Common::Postgres {
 
+/**
+ * An open PostgreSQL connection, which remembers the statements prepared on it.
+ */
+class Session : public pqxx::connection
+{
+public:
+    using pqxx::connection::connection;
+
+    /**
+     * Prepares a statement, unless it was already prepared with the same definition on this connection.
+     *
+     * Reused connections (of the global and pooled strategies) thereby parse and plan each statement only once.
+     */
+    void prepareOnce(std::string const & name, std::string const & definition)
+    {
+        auto it = statements_.find(name);
+        if (it != statements_.end() && it->second == definition)
+            return;
+        if (it != statements_.end())
+            unprepare(name);
+        prepare(name, definition);
+        statements_[name] = definition;
+    }
+
+private:
+    std::unordered_map<std::string, std::string> statements_;
+};
+
 /**
  * This class holds connection credentials and the strategy on how to deal with multiple connections.
  * A PostgreSQL connection can then be opened using those credentials with getConnection().
@@ -26,47 +58,82 @@ public:
         globalLocked,    ///< open a global connection (next connection request will block until the current connection is no longer used)
         globalUnlocked,  ///< open a global connection (without locking) (should be preferred if you only need a single connection)
         local,           ///< open a new local connection
+        pooled,          ///< reuse up to `poolSize` connections (next connection request will block while all of them are used)
     };
 
-    Connection(Strategy strategy, std::string const host, unsigned short const port, std::string const dbName, std::string const dbUser, std::string const dbPass)
-      : strategy_(strategy), host_(host), port_(port), dbName_(dbName), dbUser_(dbUser), dbPass_(dbPass)
+    /// Idle pooled connections are pinged before they are handed out again after this time.
+    static constexpr std::chrono::seconds healthCheckInterval{30};
+
+    Connection(
+        Strategy strategy,
+        std::string const host,
+        unsigned short const port,
+        std::string const dbName,
+        std::string const dbUser,
+        std::string const dbPass,
+        size_t const poolSize = 4)
+      : strategy_(strategy), host_(host), port_(port), dbName_(dbName), dbUser_(dbUser), dbPass_(dbPass),
+        pool_(poolSize, [this] { return std::make_unique<Session>(configString()); }, &isHealthy)
     {
     }
 
-    std::shared_ptr<pqxx::connection> getConnection()
+    std::shared_ptr<Session> getConnection()
     {
         switch (strategy_)
         {
             case Strategy::globalLocked:
                 mutex_.lock();
                 ensureConnection();
-                return std::shared_ptr<pqxx::connection>(connection_.get(), [&](auto p [[gnu::unused]]) { mutex_.unlock(); });
+                return std::shared_ptr<Session>(connection_.get(), [&](auto p [[gnu::unused]]) { mutex_.unlock(); });
             case Strategy::globalUnlocked: ensureConnection(); return connection_;
             case Strategy::local:
+            {
                 ensureConnection();
                 auto c = connection_;
                 connection_.reset();
                 return c;
+            }
+            case Strategy::pooled: return pool_.acquire();
         }
         return nullptr;
     }
 
 private:
     Strategy strategy_;
-    std::shared_ptr<pqxx::connection> connection_;
+    std::shared_ptr<Session> connection_;
     std::mutex mutex_;
     std::string const host_;
     unsigned short const port_;
     std::string const dbName_;
     std::string const dbUser_;
     std::string const dbPass_;
+    Generic::Pool<Session> pool_;
+
+    std::string configString() const
+    {
+        return "host='" + host_ + "' port=" + std::to_string(port_) + " dbname='" + dbName_ + "' user='" + dbUser_ + "' password='" + dbPass_ + "'";
+    }
 
     void ensureConnection()
     {
         if (!connection_)
+            connection_ = std::make_shared<Session>(configString());
+    }
+
+    static bool isHealthy(Session & session, Generic::Pool<Session>::Clock::duration const idleTime)
+    {
+        if (!session.is_open())
+            return false;
+        if (idleTime < healthCheckInterval)
+            return true;
+        try
+        {
+            pqxx::nontransaction{session}.exec("select 1");
+            return true;
+        }
+        catch (std::exception const &)
         {
-            std::string dbConfigStr = "host='" + host_ + "' port=" + std::to_string(port_) + " dbname='" + dbName_ + "' user='" + dbUser_ + "' password='" + dbPass_ + "'";
-            connection_ = std::make_shared<pqxx::connection>(dbConfigStr);
+            return false;
         }
     }
 };
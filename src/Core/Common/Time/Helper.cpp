@@ -6,22 +6,188 @@
 
 #include <Core/Common/Time/Helper.h>
 
+#include <array>
+#include <cstdint>
 #include <ctime>
 #include <iomanip>
+#include <optional>
 #include <sstream>
 
 namespace Core::Common::Time {
 
+namespace {
+
+    constexpr std::int64_t secondsPerDay = 24 * 60 * 60;
+
+    /**
+     * Days since 1970-01-01 of a date in the proleptic Gregorian calendar.
+     * Out of range days and months are carried over like `std::mktime` does, f.ex. February 30th is March 2nd.
+     * See http://howardhinnant.github.io/date_algorithms.html#days_from_civil.
+     */
+    constexpr std::int64_t daysFromCivil(std::int64_t year, std::int64_t const month, std::int64_t const day)
+    {
+        year += (month - 1) / 12 - (month < 1 ? 1 : 0);
+        auto const monthOfYear = ((month - 1) % 12 + 12) % 12 + 1;
+        year -= monthOfYear <= 2 ? 1 : 0;
+        auto const era = (year >= 0 ? year : year - 399) / 400;
+        auto const yearOfEra = year - era * 400;
+        auto const dayOfYear = (153 * (monthOfYear > 2 ? monthOfYear - 3 : monthOfYear + 9) + 2) / 5 + day - 1;
+        auto const dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    struct CivilTime
+    {
+        std::int64_t year;
+        int month;
+        int day;
+        int hour;
+        int minute;
+        int second;
+    };
+
+    /// Inverse of `daysFromCivil`, see http://howardhinnant.github.io/date_algorithms.html#civil_from_days.
+    CivilTime toCivilTime(std::chrono::system_clock::time_point const time)
+    {
+        auto const seconds = std::chrono::floor<std::chrono::seconds>(time).time_since_epoch().count();
+        auto days = seconds / secondsPerDay;
+        auto secondOfDay = seconds % secondsPerDay;
+        if (secondOfDay < 0)
+        {
+            --days;
+            secondOfDay += secondsPerDay;
+        }
+
+        days += 719468;
+        auto const era = (days >= 0 ? days : days - 146096) / 146097;
+        auto const dayOfEra = days - era * 146097;
+        auto const yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        auto const dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        auto const shiftedMonth = (5 * dayOfYear + 2) / 153;
+        auto const month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+        return {
+            yearOfEra + era * 400 + (month <= 2 ? 1 : 0),
+            static_cast<int>(month),
+            static_cast<int>(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1),
+            static_cast<int>(secondOfDay / 3600),
+            static_cast<int>(secondOfDay / 60 % 60),
+            static_cast<int>(secondOfDay % 60)};
+    }
+
+    std::string toIsoString(std::chrono::system_clock::time_point const time, bool const withZ)
+    {
+        auto const civilTime = toCivilTime(time);
+        if (civilTime.year < 0 || civilTime.year > 9999)
+            return toString(time, withZ ? "%Y-%m-%dT%H:%M:%SZ" : "%Y-%m-%dT%H:%M:%S");
+
+        auto text = std::array<char, 20>{};
+        auto writeDigits = [&text](size_t const position, std::int64_t value, size_t const digits)
+        {
+            for (size_t index = digits; index > 0; --index, value /= 10)
+                text[position + index - 1] = static_cast<char>('0' + value % 10);
+        };
+        writeDigits(0, civilTime.year, 4);
+        text[4] = '-';
+        writeDigits(5, civilTime.month, 2);
+        text[7] = '-';
+        writeDigits(8, civilTime.day, 2);
+        text[10] = 'T';
+        writeDigits(11, civilTime.hour, 2);
+        text[13] = ':';
+        writeDigits(14, civilTime.minute, 2);
+        text[16] = ':';
+        writeDigits(17, civilTime.second, 2);
+        text[19] = 'Z';
+        return std::string(text.data(), withZ ? 20 : 19);
+    }
+
+    /**
+     * Reads `YYYY-MM-DDThh:mm:ss[.fff][Z]`, where the fields may have less digits (like `std::get_time` accepts them).
+     * @return Seconds since the epoch.
+     */
+    std::optional<std::int64_t> parseIsoString(std::string_view const text, bool const requireZ)
+    {
+        size_t position = 0;
+        auto readNumber = [&](size_t const maxDigits, int const min, int const max) -> std::optional<int>
+        {
+            int value = 0;
+            size_t digits = 0;
+            while (digits < maxDigits && position < text.size() && text[position] >= '0' && text[position] <= '9')
+            {
+                value = value * 10 + (text[position] - '0');
+                ++position;
+                ++digits;
+            }
+            if (digits == 0 || value < min || value > max)
+                return std::nullopt;
+            return value;
+        };
+        auto readLiteral = [&](char const literal)
+        {
+            if (position >= text.size() || text[position] != literal)
+                return false;
+            ++position;
+            return true;
+        };
+
+        auto const year = readNumber(4, 0, 9999);
+        if (!year || !readLiteral('-'))
+            return std::nullopt;
+        auto const month = readNumber(2, 1, 12);
+        if (!month || !readLiteral('-'))
+            return std::nullopt;
+        auto const day = readNumber(2, 1, 31);
+        if (!day || !readLiteral('T'))
+            return std::nullopt;
+        auto const hour = readNumber(2, 0, 23);
+        if (!hour || !readLiteral(':'))
+            return std::nullopt;
+        auto const minute = readNumber(2, 0, 59);
+        if (!minute || !readLiteral(':'))
+            return std::nullopt;
+        auto const second = readNumber(2, 0, 60);
+        if (!second)
+            return std::nullopt;
+
+        if (readLiteral('.'))
+            while (position < text.size() && text[position] >= '0' && text[position] <= '9')
+                ++position;
+        if (requireZ && !readLiteral('Z'))
+            return std::nullopt;
+
+        return daysFromCivil(*year, *month, *day) * secondsPerDay + *hour * 3600 + *minute * 60 + *second;
+    }
+
+    std::pair<std::chrono::system_clock::time_point, bool> fromIsoString(std::string_view const text, bool const requireZ)
+    {
+        auto const seconds = parseIsoString(text, requireZ);
+        if (!seconds)
+            return {{}, false};
+        return {std::chrono::system_clock::time_point{std::chrono::seconds{*seconds}}, true};
+    }
+
+}  // namespace
+
 std::string toString(std::chrono::system_clock::time_point time, std::string const & format)
 {
     std::time_t time_t = std::chrono::system_clock::to_time_t(time);
     std::ostringstream ss;
     //ss.imbue( std::locale( "de_DE.utf-8" ) );
     std::tm tm{};
-    ss << std::put_time(localtime_r(&time_t, &tm), format.c_str());
+    ss << std::put_time(gmtime_r(&time_t, &tm), format.c_str());
     return ss.str();
 }
 
+std::string toIsoString(std::chrono::system_clock::time_point const time)
+{
+    return toIsoString(time, false);
+}
+
+std::string toIsoZString(std::chrono::system_clock::time_point const time)
+{
+    return toIsoString(time, true);
+}
+
 std::pair<std::chrono::system_clock::time_point, bool> fromString(std::string const & text, std::string const & format)
 {
     std::tm tm{};
@@ -30,8 +196,18 @@ std::pair<std::chrono::system_clock::time_point, bool> fromString(std::string co
     ss >> std::get_time(&tm, format.c_str());
     if (ss.fail())
         return {{}, false};
-    tm.tm_isdst = -1;  // TODO: check how to do it right
-    return {std::chrono::system_clock::from_time_t(std::mktime(&tm)), true};
+    auto const seconds = daysFromCivil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday) * secondsPerDay + tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+    return {std::chrono::system_clock::time_point{std::chrono::seconds{seconds}}, true};
+}
+
+std::pair<std::chrono::system_clock::time_point, bool> fromIsoString(std::string_view const text)
+{
+    return fromIsoString(text, false);
+}
+
+std::pair<std::chrono::system_clock::time_point, bool> fromIsoZString(std::string_view const text)
+{
+    return fromIsoString(text, true);
 }
 
 }  // namespace Core::Common::Time
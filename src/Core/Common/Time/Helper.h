@@ -8,46 +8,40 @@
 
 #include <chrono>
 #include <string>
+#include <string_view>
 #include <utility>
 
+/**
+ * All times are UTC, so parsing and formatting neither depend on nor lock the local timezone database and are safe to use from several threads.
+ */
 namespace Core::Common::Time {
 
 std::string toString(std::chrono::system_clock::time_point time, std::string const & format);
 
 /**
- * @return Sth. like `2018-06-22T03:14:10[.000]`.
+ * @return Sth. like `2018-06-22T03:14:10`.
  */
-inline std::string toIsoString(std::chrono::system_clock::time_point time)
-{
-    return toString(time, "%Y-%m-%dT%H:%M:%S");
-}
+std::string toIsoString(std::chrono::system_clock::time_point time);
 
 /**
- * @return Sth. like `2018-06-22T03:14:10[.000]Z`.
+ * @return Sth. like `2018-06-22T03:14:10Z`.
  */
-inline std::string toIsoZString(std::chrono::system_clock::time_point time)
-{
-    return toString(time, "%Y-%m-%dT%H:%M:%SZ");
-}
+std::string toIsoZString(std::chrono::system_clock::time_point time);
 
 std::pair<std::chrono::system_clock::time_point, bool> fromString(std::string const & text, std::string const & format);
 
 /**
+ * Fractional seconds are skipped, as is anything following the seconds.
  *
  * @param text  Sth. like `2018-06-22T03:14:10[.000]`.
  */
-inline std::pair<std::chrono::system_clock::time_point, bool> fromIsoString(std::string const & text)
-{
-    return fromString(text, "%Y-%m-%dT%H:%M:%S");
-}
+std::pair<std::chrono::system_clock::time_point, bool> fromIsoString(std::string_view text);
 
 /**
+ * Fractional seconds are skipped, as is anything following the `Z`.
  *
  * @param text  Sth. like `2018-06-22T03:14:10[.000]Z`.
  */
-inline std::pair<std::chrono::system_clock::time_point, bool> fromIsoZString(std::string const & text)
-{
-    return fromString(text, "%Y-%m-%dT%H:%M:%SZ");
-}
+std::pair<std::chrono::system_clock::time_point, bool> fromIsoZString(std::string_view text);
 
 }  // namespace Core::Common::Time
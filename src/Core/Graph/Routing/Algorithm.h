@@ -7,9 +7,12 @@
 #pragma once
 
 #include <Core/Graph/Graph.h>
+#include <Core/Graph/Routing/Path.h>
 #include <Core/Graph/Routing/PathView.h>
 
+#include <cstddef>
 #include <functional>
+#include <vector>
 
 namespace Core::Graph::Routing {
 
@@ -17,6 +20,17 @@ using CostFunction = std::function<double(Core::Graph::Edge)>;
 
 using FilterFunction = std::function<bool(PathView const &)>;
 
+/**
+ * Receives the index of a destination and the path to it, an empty path if the destination is unreachable.
+ * The path is only valid during the call.
+ */
+using DestinationVisitor = std::function<void(size_t, PathView)>;
+
+/**
+ * Like `DestinationVisitor`, but receives a path it may keep.
+ */
+using DestinationPathVisitor = std::function<void(size_t, Path &&)>;
+
 class RoutingAlgorithm
 {
 public:
@@ -28,6 +42,30 @@ public:
 
     virtual PathView run(Core::Graph::Node source, Core::Graph::Node destination) { return this->operator()(source, destination); }
 
+    /**
+     * Routes from one source to many destinations, visiting each destination exactly once.
+     * Implementations may share one search between all destinations, the default runs one search per destination.
+     */
+    virtual void runMany(Core::Graph::Node source, std::vector<Core::Graph::Node> const & destinations, DestinationVisitor const & visitor)
+    {
+        for (size_t index = 0; index < destinations.size(); ++index)
+            visitor(index, run(source, destinations[index]));
+    }
+
+    /**
+     * Routes like `run`, but returns the path in forward order and contiguous storage.
+     * Implementations may build it directly from their search, the default copies the path view.
+     */
+    virtual Path findPath(Core::Graph::Node source, Core::Graph::Node destination) { return toPath(run(source, destination)); }
+
+    /**
+     * Routes like `runMany`, see `findPath`.
+     */
+    virtual void findPaths(Core::Graph::Node source, std::vector<Core::Graph::Node> const & destinations, DestinationPathVisitor const & visitor)
+    {
+        runMany(source, destinations, [&visitor](size_t index, PathView pathView) { visitor(index, toPath(pathView)); });
+    }
+
     virtual RoutingAlgorithm & setCost(CostFunction costFuncton)
     {
         costFunction_ = costFuncton;
@@ -6,12 +6,14 @@
 
 #include <Core/Graph/Routing/Dijkstra.h>
 
-#include <cassert>
+#include <algorithm>
 #include <iostream>
+#include <unordered_map>
 
 namespace Core::Graph::Routing {
 
-Dijkstra::PathNode::PathNode(Core::Graph::Edge edge, double cost, std::shared_ptr<PathNode> const & previous) : edge_(edge), cost_(cost), previous_(previous)
+Dijkstra::PathNode::PathNode(std::vector<PathNode> & pool, Core::Graph::Edge edge, double cost, size_t parent, size_t depth)
+  : pool_(&pool), edge_(edge), cost_(cost), parent_(parent), depth_(depth)
 {
 }
 
@@ -27,7 +29,7 @@ double Dijkstra::PathNode::cost() const
 
 PathViewImpl * Dijkstra::PathNode::previous() const
 {
-    return this->previous_.get();
+    return this->parent_ == noParent ? nullptr : &(*this->pool_)[this->parent_];
 }
 
 Dijkstra::Dijkstra(Core::Graph::Graph const & graph) : graph_{graph}
@@ -35,6 +37,26 @@ Dijkstra::Dijkstra(Core::Graph::Graph const & graph) : graph_{graph}
 }
 
 PathView Dijkstra::operator()(Core::Graph::Node source, Core::Graph::Node destination)
+{
+    return this->pathView(this->search(source, destination));
+}
+
+void Dijkstra::runMany(Core::Graph::Node source, std::vector<Core::Graph::Node> const & destinations, DestinationVisitor const & visitor)
+{
+    this->searchMany(source, destinations, [&](size_t const index, size_t const node) { visitor(index, this->pathView(node)); });
+}
+
+Path Dijkstra::findPath(Core::Graph::Node source, Core::Graph::Node destination)
+{
+    return this->path(this->search(source, destination));
+}
+
+void Dijkstra::findPaths(Core::Graph::Node source, std::vector<Core::Graph::Node> const & destinations, DestinationPathVisitor const & visitor)
+{
+    this->searchMany(source, destinations, [&](size_t const index, size_t const node) { visitor(index, this->path(node)); });
+}
+
+size_t Dijkstra::search(Core::Graph::Node source, Core::Graph::Node destination)
 {
     this->init(source);
 
@@ -52,33 +74,72 @@ PathView Dijkstra::operator()(Core::Graph::Node source, Core::Graph::Node destin
         //     continue;
         // }
 
-        if (this->reached(frontier_.top(), destination))
-            return PathView(frontier_.top().get());
+        if (this->reached(frontier_.front().node, destination))
+            return frontier_.front().node;
+
+        this->enqueue(this->explore(this->pop()));
+    }
+    return PathNode::noParent;
+}
+
+template <typename NodeVisitor>
+void Dijkstra::searchMany(Core::Graph::Node source, std::vector<Core::Graph::Node> const & destinations, NodeVisitor const & visitor)
+{
+    // A destination may be requested more than once, all its indices are visited when it is reached.
+    auto pending = std::unordered_map<Core::Graph::Node, std::vector<size_t>>{};
+    for (size_t index = 0; index < destinations.size(); ++index)
+        pending[destinations[index]].push_back(index);
+
+    this->init(source);
+
+    // The search settles the destinations in order of their cost, so it only runs until the most expensive one is reached.
+    while (not frontier_.empty() and not pending.empty())
+    {
+        auto const top = this->pop();
 
-        auto top = frontier_.top();
-        frontier_.pop();
-        for (auto const & node : this->explore(top))
+        if (auto it = pending.find(graph_.target(pool_[top].edge_)); it != pending.end())
         {
-            assert(node != nullptr);
-            if (filterFunction_(PathView(node.get())))
-                frontier_.push(node);
-            else
-                visited_.erase(node->edge_);
+            for (auto index : it->second)
+                visitor(index, top);
+            pending.erase(it);
         }
+
+        this->enqueue(this->explore(top));
     }
-    return PathView(nullptr);
+
+    for (auto const & [destination, indices] : pending)
+        for (auto index : indices)
+            visitor(index, PathNode::noParent);
+}
+
+PathView Dijkstra::pathView(size_t const node)
+{
+    return PathView(node == PathNode::noParent ? nullptr : &pool_[node]);
+}
+
+Path Dijkstra::path(size_t node) const
+{
+    if (node == PathNode::noParent)
+        return {};
+
+    // The depth of the node is the path length, so the path is written back to front without reversing it.
+    auto path = Path(pool_[node].depth_, PathEdge{pool_[node].edge_, 0.0});
+    for (auto it = path.rbegin(); node != PathNode::noParent; ++it, node = pool_[node].parent_)
+        *it = {pool_[node].edge_, pool_[node].cost_};
+    return path;
 }
 
 void Dijkstra::init(Core::Graph::Node source)
 {
-    frontier_ = {};
-    visited_ = {};
+    pool_.clear();
+    frontier_.clear();
+    visited_.clear();
     for (auto edge : graph_.outEdges(source))
     {
-        frontier_.emplace(new PathNode(edge, costFunction_(edge), nullptr));
+        pool_.emplace_back(pool_, edge, costFunction_(edge), PathNode::noParent, 1);
+        this->push(pool_.size() - 1);
         visited_.insert(edge);
-        auto newNode = std::make_unique<PathNode>(edge, 0.0, nullptr);
-        //std::cerr << "Dijkstra::init() adding : " << PathView( newNode.get() ) << '\n';
+        //std::cerr << "Dijkstra::init() adding : " << PathView( &pool_.back() ) << '\n';
     }
 }
 
@@ -105,29 +166,50 @@ void Dijkstra::init(Core::Graph::Node source)
 //     return nullptr;
 // }
 
-std::vector<std::shared_ptr<Dijkstra::PathNode>> Dijkstra::explore(std::shared_ptr<PathNode> const & parent)
+size_t Dijkstra::explore(size_t const parent)
 {
-    auto const & outEdges = graph_.outEdges(graph_.target(parent->edge()));
-    auto newNodes = std::vector<std::shared_ptr<PathNode>>{};
-    for (auto edge : outEdges)
+    // The pool may grow below, so the parent is not referenced.
+    auto const parentCost = pool_[parent].cost_;
+    auto const parentDepth = pool_[parent].depth_;
+    auto const firstNode = pool_.size();
+    for (auto edge : graph_.outEdges(graph_.target(pool_[parent].edge_)))
     {
-        if (visited_.count(edge) != 0)
+        if (not visited_.insert(edge).second)
             continue;
-        visited_.insert(edge);
-        auto cost = parent->cost_ + costFunction_(edge);
-        newNodes.emplace_back(new PathNode(edge, cost, parent));
+        auto cost = parentCost + costFunction_(edge);
+        pool_.emplace_back(pool_, edge, cost, parent, parentDepth + 1);
     }
-    return newNodes;
+    return firstNode;
+}
+
+void Dijkstra::enqueue(size_t const firstNode)
+{
+    for (auto node = firstNode; node < pool_.size(); ++node)
+    {
+        if (filterFunction_(PathView(&pool_[node])))
+            this->push(node);
+        else
+            visited_.erase(pool_[node].edge_);
+    }
+}
+
+void Dijkstra::push(size_t const node)
+{
+    frontier_.push_back({pool_[node].cost_, node});
+    std::push_heap(frontier_.begin(), frontier_.end(), [](FrontierEntry const & lhs, FrontierEntry const & rhs) { return lhs.cost > rhs.cost; });
 }
 
-bool Dijkstra::reached(std::shared_ptr<PathNode> const & pathNode, Core::Graph::Node graphNode)
+size_t Dijkstra::pop()
 {
-    return graph_.target(pathNode->edge()) == graphNode;
+    std::pop_heap(frontier_.begin(), frontier_.end(), [](FrontierEntry const & lhs, FrontierEntry const & rhs) { return lhs.cost > rhs.cost; });
+    auto const node = frontier_.back().node;
+    frontier_.pop_back();
+    return node;
 }
 
-bool operator>(std::shared_ptr<Dijkstra::PathNode> const & lhs, std::shared_ptr<Dijkstra::PathNode> const & rhs)
+bool Dijkstra::reached(size_t const node, Core::Graph::Node graphNode)
 {
-    return lhs->cost() > rhs->cost();
+    return graph_.target(pool_[node].edge_) == graphNode;
 }
 
 }  // namespace Core::Graph::Routing
\ No newline at end of file
@@ -7,53 +7,95 @@
 #pragma once
 
 #include <Core/Graph/Routing/Algorithm.h>
+#include <Core/Graph/Routing/Path.h>
 #include <Core/Graph/Routing/PathView.h>
 
-#include <functional>
-#include <memory>
-#include <queue>
+#include <cstddef>
 #include <unordered_set>
+#include <vector>
 
 namespace Core::Graph::Routing {
 
 class Dijkstra : public RoutingAlgorithm
 {
 public:
+    /**
+     * Node of the search tree, stored in the pool of the algorithm and referencing its parent by index.
+     */
     class PathNode : public PathViewImpl
     {
     public:
-        PathNode(Core::Graph::Edge edge, double cost, std::shared_ptr<PathNode> const & previous);
+        static constexpr size_t noParent = static_cast<size_t>(-1);
+
+        PathNode(std::vector<PathNode> & pool, Core::Graph::Edge edge, double cost, size_t parent, size_t depth);
         Core::Graph::Edge edge() const override;
         double cost() const override;
         PathViewImpl * previous() const override;
 
+        std::vector<PathNode> * pool_;
         Core::Graph::Edge edge_;
         double cost_;
-        std::shared_ptr<PathNode> previous_;
+        size_t parent_;
+        size_t depth_;  ///< Number of edges of the path ending here.
     };
 
     Dijkstra(Core::Graph::Graph const & graph);
 
+    // The path nodes reference the pool of their algorithm.
+    Dijkstra(Dijkstra const &) = delete;
+    Dijkstra & operator=(Dijkstra const &) = delete;
+
+    /**
+     * The returned path is valid until the next search.
+     */
     PathView operator()(Core::Graph::Node source, Core::Graph::Node destination) override;
 
+    void runMany(Core::Graph::Node source, std::vector<Core::Graph::Node> const & destinations, DestinationVisitor const & visitor) override;
+
+    Path findPath(Core::Graph::Node source, Core::Graph::Node destination) override;
+
+    void findPaths(Core::Graph::Node source, std::vector<Core::Graph::Node> const & destinations, DestinationPathVisitor const & visitor) override;
+
 private:
-    using Container = std::deque<std::shared_ptr<PathNode>>;
-    using GreaterFunction = std::greater<std::shared_ptr<Dijkstra::PathNode>>;
-    using Frontier = std::priority_queue<std::shared_ptr<PathNode>, Container, GreaterFunction>;
-    using Visited = std::unordered_set<Core::Graph::Edge>;
+    struct FrontierEntry
+    {
+        double cost;
+        size_t node;  ///< Index into the pool.
+    };
+
+    /// @return The pool index of the node reaching the destination, `PathNode::noParent` if it is unreachable.
+    size_t search(Core::Graph::Node source, Core::Graph::Node destination);
+
+    /// Visits each destination index with the pool index of the node reaching it, `PathNode::noParent` if it is unreachable.
+    template <typename NodeVisitor>
+    void searchMany(Core::Graph::Node source, std::vector<Core::Graph::Node> const & destinations, NodeVisitor const & visitor);
+
+    PathView pathView(size_t node);
+    Path path(size_t node) const;
 
     void init(Core::Graph::Node source);
     // std::shared_ptr<PathNode> rollback( std::shared_ptr<PathNode> path );
-    std::vector<std::shared_ptr<PathNode>> explore(std::shared_ptr<PathNode> const & parent);
 
-    bool reached(std::shared_ptr<PathNode> const & pathNode, Core::Graph::Node graphNode);
+    /**
+     * Adds the unvisited out edges of the parent to the pool.
+     * @return The pool index of the first added node, the added nodes span to the end of the pool.
+     */
+    size_t explore(size_t parent);
+
+    /// Pushes the explored nodes passing the filter to the frontier.
+    void enqueue(size_t firstNode);
+
+    void push(size_t node);
+    size_t pop();
+
+    bool reached(size_t node, Core::Graph::Node graphNode);
 
     Core::Graph::Graph const & graph_;
 
-    Frontier frontier_;
-    Visited visited_;
+    // All containers are cleared between searches but keep their memory, so searches only allocate when they explore more than any search before.
+    std::vector<PathNode> pool_;
+    std::vector<FrontierEntry> frontier_;  ///< Binary min-heap by cost.
+    std::unordered_set<Core::Graph::Edge> visited_;
 };
 
-bool operator>(std::shared_ptr<Dijkstra::PathNode> const & lhs, std::shared_ptr<Dijkstra::PathNode> const & rhs);
-
 }  // namespace Core::Graph::Routing
\ No newline at end of file
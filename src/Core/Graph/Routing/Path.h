@@ -0,0 +1,33 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <Core/Graph/Graph.h>
+#include <Core/Graph/Routing/PathView.h>
+
+#include <vector>
+
+namespace Core::Graph::Routing {
+
+struct PathEdge
+{
+    Core::Graph::Edge edge;
+    double cost;  ///< Accumulated cost from the source up to and including this edge.
+};
+
+/**
+ * Edges from the source to the destination, empty if the destination is not reachable.
+ *
+ * Unlike a `PathView`, which walks from the destination back to the source through virtual calls, it is stored contiguously in forward order
+ * and stays valid after the next search.
+ */
+using Path = std::vector<PathEdge>;
+
+/// Copies the edges of a path view into forward order.
+Path toPath(PathView pathView);
+
+}  // namespace Core::Graph::Routing
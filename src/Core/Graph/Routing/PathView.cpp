@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <Core/Graph/Routing/Path.h>
 #include <Core/Graph/Routing/PathView.h>
 
+#include <algorithm>
 #include <ostream>
 
 namespace Core::Graph::Routing {
@@ -91,6 +93,15 @@ size_t PathView::size() const
     return count;
 }
 
+Path toPath(PathView pathView)
+{
+    auto path = Path{};
+    for (auto pv : pathView)
+        path.push_back({pv.edge(), pv.cost()});
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
 std::ostream & operator<<(std::ostream & os, PathView pathView)
 {
     for (auto pv : pathView)
@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Generic {
+
+/**
+ * Map from dense ids to values, stored in a vector indexed by id.
+ *
+ * Keys are either unsigned integers or have an `id()` member (like graph nodes and edges).
+ * Lookups are a single indexed access, so this is the fastest map for keys numbered from zero without large gaps.
+ */
+template <typename Key, typename Value>
+class DenseIdMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    void reserve(size_t const count) { values_.reserve(count); }
+
+    /// @return Whether the key was newly inserted, an existing value is not replaced.
+    bool insert(value_type const & value) { return emplace(value.first, value.second); }
+    bool insert(value_type && value) { return emplace(value.first, std::move(value.second)); }
+
+    template <typename... Args>
+    bool emplace(Key const & key, Args &&... args)
+    {
+        auto const index = id(key);
+        if (index >= values_.size())
+            values_.resize(index + 1);
+        if (values_[index])
+            return false;
+        values_[index].emplace(std::forward<Args>(args)...);
+        ++size_;
+        return true;
+    }
+
+    size_t count(Key const & key) const { return find(key) ? 1 : 0; }
+
+    /// @return The value of \p key or `nullptr`.
+    Value const * find(Key const & key) const
+    {
+        auto const index = id(key);
+        return index < values_.size() && values_[index] ? &*values_[index] : nullptr;
+    }
+
+    Value const & at(Key const & key) const
+    {
+        if (auto const value = find(key))
+            return *value;
+        throw std::out_of_range("DenseIdMap::at");
+    }
+
+    Value & at(Key const & key) { return const_cast<Value &>(static_cast<DenseIdMap const &>(*this).at(key)); }
+
+private:
+    static size_t id(Key const & key)
+    {
+        if constexpr (std::is_integral_v<Key>)
+            return static_cast<size_t>(key);
+        else
+            return key.id();
+    }
+
+    std::vector<std::optional<Value>> values_;
+    size_t size_{0};
+};
+
+}  // namespace Generic
@@ -0,0 +1,318 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Generic {
+
+namespace Detail {
+
+    /// Finalizer of MurmurHash3, spreads weak hashes (like identity hashes of ids or `hash_combine` of small integers) over all bits.
+    inline size_t mixHash(size_t const hash)
+    {
+        auto x = static_cast<std::uint64_t>(hash);
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return static_cast<size_t>(x);
+    }
+
+    /**
+     * Open addressing hash table with linear probing, all slots are stored in one contiguous array.
+     *
+     * @tparam GetKey Returns the key of a slot.
+     */
+    template <typename Key, typename Slot, typename GetKey, typename Hash, typename KeyEqual>
+    class FlatHashTable
+    {
+    public:
+        template <bool isConst>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Slot;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<isConst, Slot const *, Slot *>;
+            using reference = std::conditional_t<isConst, Slot const &, Slot &>;
+            using Table = std::conditional_t<isConst, FlatHashTable const, FlatHashTable>;
+
+            Iterator() = default;
+            Iterator(Table * table, size_t index) : table_(table), index_(index) { skipUnused(); }
+            operator Iterator<true>() const { return {table_, index_}; }
+
+            reference operator*() const { return table_->slots_[index_]; }
+            pointer operator->() const { return &table_->slots_[index_]; }
+            Iterator & operator++()
+            {
+                ++index_;
+                skipUnused();
+                return *this;
+            }
+            Iterator operator++(int)
+            {
+                auto it = *this;
+                ++*this;
+                return it;
+            }
+            bool operator==(Iterator const & other) const { return index_ == other.index_; }
+            bool operator!=(Iterator const & other) const { return index_ != other.index_; }
+
+        private:
+            friend class FlatHashTable;
+
+            void skipUnused()
+            {
+                while (index_ < table_->used_.size() && !table_->used_[index_])
+                    ++index_;
+            }
+
+            Table * table_{nullptr};
+            size_t index_{0};
+        };
+
+        using key_type = Key;
+        using value_type = Slot;
+        using size_type = size_t;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        iterator begin() { return {this, 0}; }
+        iterator end() { return {this, slots_.size()}; }
+        const_iterator begin() const { return {this, 0}; }
+        const_iterator end() const { return {this, slots_.size()}; }
+
+        bool empty() const { return size_ == 0; }
+        size_t size() const { return size_; }
+
+        /// Removes all entries but keeps the allocated memory.
+        void clear()
+        {
+            for (size_t index = 0; index < slots_.size(); ++index)
+                if (used_[index])
+                    slots_[index] = Slot{};
+            std::fill(used_.begin(), used_.end(), std::uint8_t{0});
+            size_ = 0;
+        }
+
+        /// Makes room for \p count entries without further rehashing.
+        void reserve(size_t const count)
+        {
+            if (count * maxLoadDenominator > slots_.size() * maxLoadNumerator)
+                rehash(count * maxLoadDenominator / maxLoadNumerator + 1);
+        }
+
+        iterator find(Key const & key)
+        {
+            auto const index = findIndex(key);
+            return index == npos ? end() : iterator{this, index};
+        }
+
+        const_iterator find(Key const & key) const
+        {
+            auto const index = findIndex(key);
+            return index == npos ? end() : const_iterator{this, index};
+        }
+
+        size_t count(Key const & key) const { return findIndex(key) == npos ? 0 : 1; }
+
+        size_t erase(Key const & key)
+        {
+            auto index = findIndex(key);
+            if (index == npos)
+                return 0;
+
+            // Backward shift deletion: move following entries of the probe sequence into the gap, so no tombstones are needed.
+            auto const mask = slots_.size() - 1;
+            for (auto next = (index + 1) & mask; used_[next]; next = (next + 1) & mask)
+            {
+                auto const home = homeIndex(GetKey{}(slots_[next]));
+                auto const inGap = index <= next ? (home <= index || home > next) : (home <= index && home > next);
+                if (inGap)
+                {
+                    slots_[index] = std::move(slots_[next]);
+                    index = next;
+                }
+            }
+            slots_[index] = Slot{};
+            used_[index] = 0;
+            --size_;
+            return 1;
+        }
+
+    protected:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        size_t findIndex(Key const & key) const
+        {
+            if (size_ == 0)
+                return npos;
+            auto const mask = slots_.size() - 1;
+            for (auto index = homeIndex(key); used_[index]; index = (index + 1) & mask)
+                if (keyEqual_(GetKey{}(slots_[index]), key))
+                    return index;
+            return npos;
+        }
+
+        /**
+         * @return The slot index of \p key and whether it was newly occupied, a new slot only has its key assigned.
+         */
+        std::pair<size_t, bool> findOrOccupy(Key const & key)
+        {
+            if (auto const index = findIndex(key); index != npos)
+                return {index, false};
+
+            reserve(size_ + 1);
+            auto const mask = slots_.size() - 1;
+            auto index = homeIndex(key);
+            while (used_[index])
+                index = (index + 1) & mask;
+            used_[index] = 1;
+            ++size_;
+            return {index, true};
+        }
+
+        std::vector<Slot> slots_;
+
+    private:
+        // The table grows when more than 3/4 of the slots are used, which keeps the probe sequences short.
+        static constexpr size_t maxLoadNumerator = 3;
+        static constexpr size_t maxLoadDenominator = 4;
+        static constexpr size_t minCapacity = 16;
+
+        size_t homeIndex(Key const & key) const { return mixHash(hash_(key)) & (slots_.size() - 1); }
+
+        void rehash(size_t minSlots)
+        {
+            auto capacity = minCapacity;
+            while (capacity < minSlots)
+                capacity *= 2;
+
+            auto slots = std::vector<Slot>(capacity);
+            auto used = std::vector<std::uint8_t>(capacity, 0);
+            std::swap(slots, slots_);
+            std::swap(used, used_);
+
+            auto const mask = capacity - 1;
+            for (size_t oldIndex = 0; oldIndex < slots.size(); ++oldIndex)
+            {
+                if (!used[oldIndex])
+                    continue;
+                auto index = homeIndex(GetKey{}(slots[oldIndex]));
+                while (used_[index])
+                    index = (index + 1) & mask;
+                slots_[index] = std::move(slots[oldIndex]);
+                used_[index] = 1;
+            }
+        }
+
+        std::vector<std::uint8_t> used_;
+        size_t size_{0};
+        Hash hash_;
+        KeyEqual keyEqual_;
+    };
+
+    struct PairFirst
+    {
+        template <typename Pair>
+        auto const & operator()(Pair const & pair) const
+        {
+            return pair.first;
+        }
+    };
+
+    struct Identity
+    {
+        template <typename T>
+        T const & operator()(T const & value) const
+        {
+            return value;
+        }
+    };
+
+}  // namespace Detail
+
+/**
+ * Cache-friendly replacement for `std::unordered_map` in lookup-heavy code.
+ *
+ * The entries are stored in one contiguous array (open addressing), instead of one allocation per node.
+ * Keys and values must be default constructible.
+ * Unlike `std::unordered_map`, inserting and erasing invalidates all iterators and references.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class FlatHashMap : public Detail::FlatHashTable<Key, std::pair<Key, Value>, Detail::PairFirst, Hash, KeyEqual>
+{
+    using Base = Detail::FlatHashTable<Key, std::pair<Key, Value>, Detail::PairFirst, Hash, KeyEqual>;
+
+public:
+    using mapped_type = Value;
+    using typename Base::iterator;
+    using typename Base::value_type;
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(Key const & key, Args &&... args)
+    {
+        auto const [index, inserted] = this->findOrOccupy(key);
+        if (inserted)
+            this->slots_[index] = value_type{key, Value(std::forward<Args>(args)...)};
+        return {iterator{this, index}, inserted};
+    }
+
+    std::pair<iterator, bool> insert(value_type const & value) { return try_emplace(value.first, value.second); }
+    std::pair<iterator, bool> insert(value_type && value) { return try_emplace(value.first, std::move(value.second)); }
+
+    Value & operator[](Key const & key) { return try_emplace(key).first->second; }
+
+    Value & at(Key const & key)
+    {
+        auto const index = this->findIndex(key);
+        if (index == Base::npos)
+            throw std::out_of_range("FlatHashMap::at");
+        return this->slots_[index].second;
+    }
+
+    Value const & at(Key const & key) const
+    {
+        auto const index = this->findIndex(key);
+        if (index == Base::npos)
+            throw std::out_of_range("FlatHashMap::at");
+        return this->slots_[index].second;
+    }
+};
+
+/**
+ * Cache-friendly replacement for `std::unordered_set`, see `FlatHashMap`.
+ */
+template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class FlatHashSet : public Detail::FlatHashTable<Key, Key, Detail::Identity, Hash, KeyEqual>
+{
+    using Base = Detail::FlatHashTable<Key, Key, Detail::Identity, Hash, KeyEqual>;
+
+public:
+    using typename Base::iterator;
+
+    std::pair<iterator, bool> insert(Key const & key)
+    {
+        auto const [index, inserted] = this->findOrOccupy(key);
+        if (inserted)
+            this->slots_[index] = key;
+        return {iterator{this, index}, inserted};
+    }
+};
+
+}  // namespace Generic
@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <vector>
+
+namespace Generic::Parallel {
+
+/**
+ * Calls \p function with the consecutive ranges `[begin, end)` of at most \p batchSize indices of `[0, count)`, on up to \p threadCount threads (including the calling one).
+ *
+ * Batches are handed out in order as threads get idle, so batches of very different cost are balanced.
+ * Results written per index (f.ex. to a list resized up front) are therefore independent of the thread count.
+ * @throws The first exception thrown by \p function, after all threads finished. No further batches are started once it was thrown.
+ */
+template <typename Function>
+void forEachBatch(size_t const count, size_t const batchSize, size_t const threadCount, Function const & function)
+{
+    auto const batchCount = (count + batchSize - 1) / batchSize;
+    auto nextBatch = std::atomic<size_t>{0};
+    auto processBatches = [&]
+    {
+        for (auto batch = nextBatch++; batch < batchCount; batch = nextBatch++)
+        {
+            try
+            {
+                function(batch * batchSize, std::min(count, (batch + 1) * batchSize));
+            }
+            catch (...)
+            {
+                // Let the other threads stop early.
+                nextBatch = batchCount;
+                throw;
+            }
+        }
+    };
+
+    auto workers = std::vector<std::future<void>>{};
+    for (size_t thread = 1; thread < std::min(threadCount, batchCount); ++thread)
+        workers.push_back(std::async(std::launch::async, processBatches));
+    auto error = std::exception_ptr{};
+    try
+    {
+        processBatches();
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    for (auto & worker : workers)
+    {
+        try
+        {
+            worker.get();
+        }
+        catch (...)
+        {
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+/**
+ * Sorts like `std::sort` on up to \p threadCount threads: runs are sorted by one thread each, then neighbouring runs are merged pairwise.
+ *
+ * Like `std::sort`, it is not stable, the order of elements is only deterministic if \p compare is a total order.
+ */
+template <typename RandomIt, typename Compare>
+void sort(RandomIt const begin, RandomIt const end, Compare const compare, size_t const threadCount)
+{
+    // Below this length per thread, starting threads costs more than it saves.
+    constexpr size_t minRunLength = 4096;
+
+    auto const count = static_cast<size_t>(std::distance(begin, end));
+    auto const runCount = std::max(size_t{1}, std::min(threadCount, count / minRunLength));
+    auto const runLength = (count + runCount - 1) / runCount;
+    auto at = [&](size_t const index) { return begin + static_cast<typename std::iterator_traits<RandomIt>::difference_type>(std::min(count, index)); };
+
+    forEachBatch(
+        runCount,
+        1,
+        threadCount,
+        [&](size_t const run, size_t)
+        {
+            std::sort(at(run * runLength), at((run + 1) * runLength), compare);
+        });
+    for (auto width = runLength; width < count; width *= 2)
+        forEachBatch(
+            (count + 2 * width - 1) / (2 * width),
+            1,
+            threadCount,
+            [&](size_t const merge, size_t)
+            {
+                std::inplace_merge(at(2 * merge * width), at((2 * merge + 1) * width), at((2 * merge + 2) * width), compare);
+            });
+}
+
+}  // namespace Generic::Parallel
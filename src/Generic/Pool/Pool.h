@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Generic {
+
+/**
+ * Thread-safe pool of expensive objects (f.ex. database connections), which are created on demand and reused.
+ *
+ * At most `size` objects exist at once, acquiring blocks while all of them are in use.
+ * Objects are checked before they are handed out again and replaced if they are broken.
+ */
+template <typename T>
+class Pool
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Factory = std::function<std::unique_ptr<T>()>;
+    /// @return False if the object is broken. Gets the time the object was idle, so expensive checks can be limited to long idle objects.
+    using HealthCheck = std::function<bool(T &, Clock::duration idleTime)>;
+
+    Pool(size_t const size, Factory factory, HealthCheck healthCheck) : state_(std::make_shared<State>(std::max(size_t{1}, size), std::move(factory), std::move(healthCheck)))
+    {
+    }
+
+    /**
+     * @return An idle object, or a new one if there is none and the pool is not full. It returns to the pool when the last copy of the pointer is destroyed.
+     * @throws Whatever the factory throws, the pool stays usable.
+     */
+    std::shared_ptr<T> acquire()
+    {
+        auto object = std::unique_ptr<T>{};
+        auto idleTime = Clock::duration{};
+        {
+            auto lock = std::unique_lock<std::mutex>{state_->mutex};
+            state_->available.wait(lock, [&] { return !state_->idle.empty() || state_->count < state_->size; });
+            if (!state_->idle.empty())
+            {
+                // The most recently used object is the least likely to have timed out.
+                object = std::move(state_->idle.back().object);
+                idleTime = Clock::now() - state_->idle.back().since;
+                state_->idle.pop_back();
+            }
+            else
+                ++state_->count;
+        }
+
+        // Checking and creating (f.ex. connecting) happen outside the lock, the slot is reserved by `count`.
+        try
+        {
+            if (object && !state_->healthCheck(*object, idleTime))
+                object.reset();
+            if (!object)
+                object = state_->factory();
+        }
+        catch (...)
+        {
+            auto lock = std::lock_guard<std::mutex>{state_->mutex};
+            --state_->count;
+            state_->available.notify_one();
+            throw;
+        }
+
+        return std::shared_ptr<T>{object.release(), [state = state_](T * released) { state->release(std::unique_ptr<T>{released}); }};
+    }
+
+private:
+    struct Idle
+    {
+        std::unique_ptr<T> object;
+        Clock::time_point since;
+    };
+
+    /// Shared with the acquired objects, so they can be returned after the pool is destroyed.
+    struct State
+    {
+        State(size_t const size, Factory factory, HealthCheck healthCheck) : size(size), factory(std::move(factory)), healthCheck(std::move(healthCheck)) {}
+
+        void release(std::unique_ptr<T> object)
+        {
+            auto lock = std::lock_guard<std::mutex>{mutex};
+            idle.push_back({std::move(object), Clock::now()});
+            available.notify_one();
+        }
+
+        size_t const size;
+        Factory const factory;
+        HealthCheck const healthCheck;
+        std::mutex mutex;
+        std::condition_variable available;
+        std::vector<Idle> idle;
+        size_t count{0};  ///< Objects which are idle, in use or being created.
+    };
+
+    std::shared_ptr<State> state_;
+};
+
+}  // namespace Generic
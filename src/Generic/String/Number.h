@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace Generic::String {
+
+/**
+ * Parses the decimal floating point number at the start of \p text like `std::from_chars`, without allocating.
+ *
+ * Leading whitespace and plus signs are not accepted, hexadecimal numbers are not supported.
+ * @return The number of characters of the number, 0 if the text does not start with a number or it is out of range.
+ */
+inline size_t parseDouble(std::string_view const text, double & value)
+{
+    if (text.empty() || text.front() == '+' || std::isspace(static_cast<unsigned char>(text.front())))
+        return 0;
+#if defined(__cpp_lib_to_chars)
+    auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc{})
+        return 0;
+    return static_cast<size_t>(end - text.data());
+#else
+    // Floating point `std::from_chars` is not available, `std::strtod` needs a terminated copy.
+    auto buffer = std::array<char, 64>{};
+    auto const length = std::min(text.size(), buffer.size() - 1);
+    std::memcpy(buffer.data(), text.data(), length);
+    char * end = nullptr;
+    errno = 0;
+    auto const result = std::strtod(buffer.data(), &end);
+    if (end == buffer.data() || errno == ERANGE)
+        return 0;
+    value = result;
+    return static_cast<size_t>(end - buffer.data());
+#endif
+}
+
+/**
+ * Appends \p value to \p buffer like `printf("%.*g", precision, value)` (or a stream with `std::setprecision(precision)`) does, without allocating.
+ */
+inline void appendDouble(std::string & buffer, double const value, int const precision)
+{
+    auto chars = std::array<char, 32>{};
+#if defined(__cpp_lib_to_chars)
+    auto const [end, error] = std::to_chars(chars.data(), chars.data() + chars.size(), value, std::chars_format::general, precision);
+    buffer.append(chars.data(), error == std::errc{} ? end : chars.data());
+#else
+    auto const length = std::snprintf(chars.data(), chars.size(), "%.*g", precision, value);
+    buffer.append(chars.data(), static_cast<size_t>(std::max(0, std::min(length, static_cast<int>(chars.size()) - 1))));
+#endif
+}
+
+}  // namespace Generic::String
@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "StreetGrid.h"
+
+#include <AppComponents/Common/Matcher/GraphBuilder.h>
+#include <AppComponents/Common/Matcher/SamplingPointFinder.h>
+#include <AppComponents/Common/Types/Track/Heading.h>
+
+#include <Core/Common/Geometry/Helper.h>
+
+#include <chrono>
+#include <cmath>
+
+using namespace AppComponents::Common;
+using Core::Common::Geometry::Point;
+
+StreetGrid::StreetGrid(size_t const size)
+{
+    auto const junctionId = [&](size_t const column, size_t const row) { return row * size + column; };
+    auto const addStreet = [&](size_t const column1, size_t const row1, size_t const column2, size_t const row2)
+    {
+        segmentList.push_back({segmentList.size(), 0, Core::Common::Geometry::LineString{junction(column1, row1), junction(column2, row2)}});
+        nodePairList.emplace_back(junctionId(column1, row1), junctionId(column2, row2));
+        travelDirectionList.push_back(Types::Street::TravelDirection::both);
+    };
+    for (size_t row = 0; row < size; ++row)
+        for (size_t column = 0; column < size; ++column)
+        {
+            if (column + 1 < size)
+                addStreet(column, row, column + 1, row);
+            if (row + 1 < size)
+                addStreet(column, row, column, row + 1);
+        }
+
+    Matcher::GraphBuilder{nodePairList, travelDirectionList}(graph, graphEdgeMap, streetIndexMap, nodeMap);
+}
+
+Point StreetGrid::junction(size_t const column, size_t const row)
+{
+    return Point{Point::Longitude{static_cast<double>(column) * spacing}, Point::Latitude{static_cast<double>(row) * spacing}};
+}
+
+Matcher::Routing::StreetLengthRouting StreetGrid::makeRouting(Types::Routing::SamplingPointList const & samplingPointList) const
+{
+    static auto const timeList = Types::Track::TimeList{};
+    static auto const velocityList = Types::Track::VelocityList{};
+    return {{10.0, true, 360.0, 5.0}, samplingPointList, graph, graphEdgeMap, streetIndexMap, timeList, velocityList, segmentList, nullptr, Types::Routing::makeArena()};
+}
+
+GridTrack::GridTrack(StreetGrid const & grid, std::vector<Point> const & waypoints, double const pointSpacing, double const velocity)
+{
+    auto time = Types::Track::Time{std::chrono::hours{24 * 365 * 50}};
+    auto addPoint = [&](Point const & point)
+    {
+        if (!pointList.empty())
+            time += std::chrono::duration_cast<Types::Track::Time::duration>(std::chrono::duration<double>{Core::Common::Geometry::geoDistance(pointList.back(), point) / velocity});
+        pointList.push_back(point);
+        timeList.push_back(time);
+        velocityList.push_back(velocity);
+    };
+
+    addPoint(waypoints.front());
+    for (size_t index = 1; index < waypoints.size(); ++index)
+    {
+        auto const & from = waypoints[index - 1];
+        auto const & to = waypoints[index];
+        auto const steps = static_cast<size_t>(std::ceil(std::hypot(to.lon() - from.lon(), to.lat() - from.lat()) / pointSpacing));
+        for (size_t step = 1; step <= steps; ++step)
+        {
+            auto const ratio = static_cast<double>(step) / static_cast<double>(steps);
+            addPoint(Point{Point::Longitude{from.lon() + ratio * (to.lon() - from.lon())}, Point::Latitude{from.lat() + ratio * (to.lat() - from.lat())}});
+        }
+    }
+
+    auto const headingList = Types::Track::HeadingList{};
+    Matcher::SamplingPointFinder{Matcher::SamplingPointFinder::SelectionStrategy::all, searchRadius, 90.0, pointList, headingList, grid.segmentList, grid.travelDirectionList}(
+        samplingPointList);
+}
@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <AppComponents/Common/Matcher/Routing/StreetLengthRouting.h>
+#include <AppComponents/Common/Types/Graph/EdgeMap.h>
+#include <AppComponents/Common/Types/Graph/LemonDigraph.h>
+#include <AppComponents/Common/Types/Routing/SamplingPoint.h>
+#include <AppComponents/Common/Types/Street/NodePair.h>
+#include <AppComponents/Common/Types/Street/Segment.h>
+#include <AppComponents/Common/Types/Street/TravelDirection.h>
+#include <AppComponents/Common/Types/Track/Point.h>
+#include <AppComponents/Common/Types/Track/Time.h>
+#include <AppComponents/Common/Types/Track/Velocity.h>
+
+#include <Core/Common/Geometry/Types.h>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Two-way streets between the junctions of a square grid, with their graph, to match tracks on.
+ */
+struct StreetGrid
+{
+    /// Distance between neighbouring junctions in degrees (about 111 m).
+    static constexpr double spacing = 0.001;
+
+    /// @param size Number of junctions per row and column, the first one lies at 0/0.
+    explicit StreetGrid(size_t size);
+
+    static Core::Common::Geometry::Point junction(size_t column, size_t row);
+
+    /// Routes by street length between the candidates of \p samplingPointList, without rejecting any route for its velocity.
+    AppComponents::Common::Matcher::Routing::StreetLengthRouting makeRouting(AppComponents::Common::Types::Routing::SamplingPointList const & samplingPointList) const;
+
+    AppComponents::Common::Types::Street::SegmentList segmentList;
+    AppComponents::Common::Types::Street::NodePairList nodePairList;
+    AppComponents::Common::Types::Street::TravelDirectionList travelDirectionList;
+    AppComponents::Common::Types::Graph::LemonDigraph graph;
+    AppComponents::Common::Types::Graph::GraphEdgeMap graphEdgeMap;
+    AppComponents::Common::Types::Graph::StreetIndexMap streetIndexMap;
+    AppComponents::Common::Types::Graph::NodeMap nodeMap;
+};
+
+/**
+ * Track driven along the straight lines between waypoints at constant velocity, with its sampling points on a street grid.
+ */
+struct GridTrack
+{
+    static constexpr double searchRadius = 30.0;
+
+    /// @param pointSpacing Distance between the track points in degrees.
+    /// @param velocity In m/s.
+    GridTrack(StreetGrid const & grid, std::vector<Core::Common::Geometry::Point> const & waypoints, double pointSpacing, double velocity);
+
+    AppComponents::Common::Types::Track::PointList pointList;
+    AppComponents::Common::Types::Track::TimeList timeList;
+    AppComponents::Common::Types::Track::VelocityList velocityList;
+    AppComponents::Common::Types::Routing::SamplingPointList samplingPointList;
+};
@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/**
+ * File with the given content in the temporary directory, for readers which take a file name. It is removed on destruction.
+ */
+class TemporaryFile
+{
+public:
+    explicit TemporaryFile(std::string const & content)
+      : path_(std::filesystem::temp_directory_path() / ("os_matcher_unit_test_" + std::to_string(nextId_++)))
+    {
+        std::ofstream{path_, std::ios::binary} << content;
+    }
+    ~TemporaryFile() { std::filesystem::remove(path_); }
+
+    TemporaryFile(TemporaryFile const &) = delete;
+    TemporaryFile & operator=(TemporaryFile const &) = delete;
+
+    std::string path() const { return path_.string(); }
+
+private:
+    static inline std::atomic<size_t> nextId_{0};
+    std::filesystem::path const path_;
+};
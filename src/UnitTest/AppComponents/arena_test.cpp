@@ -0,0 +1,170 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "StreetGrid.h"
+
+#include <AppComponents/Common/Matcher/Router.h>
+#include <AppComponents/Common/Matcher/Routing/Helper.h>
+#include <AppComponents/Common/Matcher/ViterbiRouter.h>
+#include <AppComponents/Common/Types/Routing/Arena.h>
+#include <AppComponents/Common/Types/Routing/Edge.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+using namespace AppComponents::Common;
+
+namespace {
+
+/// Heap arena which reports its destruction and the bytes allocated from it.
+class TrackedArena : public std::pmr::memory_resource
+{
+public:
+    TrackedArena(bool & destroyed, size_t & allocated) : destroyed_(destroyed), allocated_(allocated) {}
+    ~TrackedArena() override { destroyed_ = true; }
+
+private:
+    void * do_allocate(size_t const bytes, size_t const alignment) override
+    {
+        allocated_ += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void * const pointer, size_t const bytes, size_t const alignment) override
+    {
+        allocated_ -= bytes;
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+    bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override { return this == &other; }
+
+    bool & destroyed_;
+    size_t & allocated_;
+};
+
+Core::Common::Geometry::LineString const street{};
+
+/// Route along the only edge of a graph.
+struct RouteFactory
+{
+    RouteFactory() : source(graph.createNode()), target(graph.createNode()), edge(graph.addEdge(source, target)) {}
+
+    std::shared_ptr<Types::Routing::Route> operator()(std::shared_ptr<Types::Routing::Arena> const & arena) const
+    {
+        auto route = std::allocate_shared<Types::Routing::Route>(
+            Types::Routing::ArenaAllocator<Types::Routing::Route>{arena}, Types::Routing::RouteNode{source, {0, {0, true}}}, Types::Routing::RouteNode{target, {1, {0, true}}}, arena.get());
+        route->subRoutes.push_back({edge, 2.0, {street, 0, 0, true}, 3.0});
+        return route;
+    }
+
+    Types::Graph::LemonDigraph graph;
+    Types::Routing::Node const source;
+    Types::Routing::Node const target;
+    Types::Routing::Edge const edge;
+};
+
+}  // namespace
+
+SCENARIO("Routes keep their arena alive", "[Arena]")
+{
+    GIVEN("routes allocated from an arena which is no longer referenced otherwise")
+    {
+        bool destroyed = false;
+        size_t allocated = 0;
+        auto const makeRoute = RouteFactory{};
+        auto arena = std::shared_ptr<Types::Routing::Arena>{std::make_shared<TrackedArena>(destroyed, allocated)};
+        auto routeList = Types::Routing::RouteList{makeRoute(arena), makeRoute(arena)};
+        arena = nullptr;
+
+        THEN("the routes and their sub routes are allocated from the arena")
+        {
+            CHECK(allocated > 0);
+            CHECK(!destroyed);
+        }
+
+        WHEN("the routes are dropped one by one")
+        {
+            routeList.pop_back();
+
+            THEN("the arena lives until the last one is dropped")
+            {
+                CHECK(!destroyed);
+                routeList.clear();
+                CHECK(destroyed);
+            }
+        }
+
+        WHEN("the routes are copied to the heap")
+        {
+            Matcher::Routing::copyToHeap(routeList);
+
+            THEN("the arena is released")
+            {
+                CHECK(destroyed);
+            }
+
+            THEN("the copies keep the route data on the default resource")
+            {
+                for (auto const & route : routeList)
+                {
+                    CHECK(route->source.node == makeRoute.source);
+                    CHECK(route->source.samplingPoint.index == 0);
+                    CHECK(route->target.samplingPoint.index == 1);
+                    REQUIRE(route->subRoutes.size() == 1);
+                    CHECK(route->cost() == 2.0);
+                    CHECK(route->length() == 3.0);
+                    CHECK(route->subRoutes.get_allocator().resource() == std::pmr::get_default_resource());
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Matched routes do not hold the arena of the match", "[Arena]")
+{
+    GIVEN("a track on a grid")
+    {
+        auto const grid = StreetGrid{3};
+        auto const track = GridTrack{grid, {StreetGrid::junction(0, 0), StreetGrid::junction(2, 0), StreetGrid::junction(2, 2)}, 0.0003, 10.0};
+
+        auto requireHeapRoutes = [](Types::Routing::RouteList const & routeList)
+        {
+            REQUIRE(!routeList.empty());
+            for (auto const & route : routeList)
+                REQUIRE(route->subRoutes.get_allocator().resource() == std::pmr::get_default_resource());
+        };
+
+        THEN("the routes of the Router are on the heap")
+        {
+            auto routeList = Types::Routing::RouteList{};
+            auto routingStatistic = Types::Routing::RoutingStatistic{};
+            Matcher::Router{
+                10.0,
+                true,
+                360.0,
+                5.0,
+                3000.0,
+                Matcher::Routing::SamplingPointSkipStrategy::excludeEdgeCosts,
+                1000.0,
+                4.0 * GridTrack::searchRadius,
+                Matcher::Routing::RouteClusterPreference::shortest,
+                track.timeList,
+                track.velocityList,
+                grid.segmentList}(track.samplingPointList, grid.graph, grid.graphEdgeMap, grid.streetIndexMap, routeList, routingStatistic);
+            requireHeapRoutes(routeList);
+        }
+
+        THEN("the routes of the ViterbiRouter are on the heap")
+        {
+            auto routeList = Types::Routing::RouteList{};
+            auto routingStatistic = Types::Routing::RoutingStatistic{};
+            Matcher::ViterbiRouter{10.0, true, 360.0, 5.0, 5.0, 10.0, 20.0, 0, track.timeList, track.velocityList, grid.segmentList}(
+                track.samplingPointList, grid.graph, grid.graphEdgeMap, grid.streetIndexMap, routeList, routingStatistic);
+            requireHeapRoutes(routeList);
+        }
+    }
+}
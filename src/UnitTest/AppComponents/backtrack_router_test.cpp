@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "StreetGrid.h"
+
+#include <AppComponents/Common/Matcher/Routing/BacktrackRouter.h>
+#include <AppComponents/Common/Matcher/Routing/Helper.h>
+#include <AppComponents/Common/Matcher/Routing/RouteJournal.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <limits>
+
+using namespace AppComponents::Common;
+using namespace AppComponents::Common::Matcher::Routing;
+
+namespace {
+
+/**
+ * Routes a track with an unreachable last sampling point, so the router backtracks as far as it may.
+ * @return The smallest sampling point routed from while backtracking.
+ */
+size_t backtrackingDepth(StreetGrid const & grid, GridTrack const & track, double const maxBacktrackingDistance)
+{
+    auto const streetLengthRouting = StreetLengthRouting{
+        {10.0, true, 360.0, 5.0},
+        track.samplingPointList,
+        grid.graph,
+        grid.graphEdgeMap,
+        grid.streetIndexMap,
+        track.timeList,
+        track.velocityList,
+        grid.segmentList,
+        nullptr,
+        Types::Routing::makeArena()};
+    auto const samplingPointRouter
+        = SamplingPointRouter{streetLengthRouting.router(), {4.0 * GridTrack::searchRadius, RouteClusterPreference::shortest, 0}, track.samplingPointList, grid.graphEdgeMap};
+    auto const samplingPointLocationList = calcSamplingPointLocations(track.samplingPointList);
+    auto const backtrackRouter = BacktrackRouter{samplingPointRouter, {maxBacktrackingDistance}, track.samplingPointList, samplingPointLocationList, track.timeList};
+
+    auto const goal = track.samplingPointList.size() - 1;
+    auto routeList = Types::Routing::RouteList{};
+    auto journal = RouteJournal{routeList};
+    auto routeMap = SamplingPointRouter::RouteMap{};
+    auto routingStatistic = Types::Routing::RoutingStatistic{};
+    backtrackRouter(0, 0, goal, Matcher::Routing::Generic::IndexSet{}, routeMap, journal, routingStatistic);
+
+    // Everything routed after the first attempt to reach the goal is routed while backtracking.
+    auto const & visited = routingStatistic.visited;
+    auto const firstGoalAttempt
+        = std::find_if(visited.begin(), visited.end(), [&](auto const & entry) { return entry.first.target.index == goal && !entry.second; });
+    REQUIRE(firstGoalAttempt != visited.end());
+    auto depth = std::numeric_limits<size_t>::max();
+    for (auto entry = firstGoalAttempt; entry != visited.end(); ++entry)
+        depth = std::min(depth, entry->first.source.index);
+    return depth;
+}
+
+}  // namespace
+
+SCENARIO("The backtracking distance is measured in a straight line", "[BacktrackRouter]")
+{
+    GIVEN("a track turning back on the next street, with an unreachable last sampling point")
+    {
+        auto const grid = StreetGrid{4};
+        // Sampling points every 56 m: 0 to 6 lead east, 7 and 8 north and 9 to 14 back west.
+        auto track = GridTrack{grid, {StreetGrid::junction(0, 0), StreetGrid::junction(3, 0), StreetGrid::junction(3, 1), StreetGrid::junction(0, 1)}, 0.00051, 10.0};
+        REQUIRE(track.samplingPointList.size() == 15);
+        // No time passes to the last point, so every route to it is too fast.
+        track.timeList.back() = track.timeList[track.timeList.size() - 2];
+
+        WHEN("the street back lies within the backtracking distance")
+        {
+            // Sampling point 13 is at most 300 m from all others in a straight line, but 389 m along the track from sampling point 6.
+            THEN("the router backtracks to the start of the track")
+            {
+                REQUIRE(backtrackingDepth(grid, track, 350.0) == 0);
+            }
+        }
+        WHEN("the street back lies outside the backtracking distance")
+        {
+            THEN("the router backtracks along the street back up to the distance")
+            {
+                // Sampling point 10 is 167 m and sampling point 9 is 222 m from sampling point 13.
+                REQUIRE(backtrackingDepth(grid, track, 200.0) == 10);
+            }
+        }
+    }
+}
@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "StreetGrid.h"
+
+#include <AppComponents/Common/Matcher/BatchRouter.h>
+#include <AppComponents/Common/Matcher/Router.h>
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace AppComponents::Common;
+
+namespace {
+
+struct Configuration
+{
+    double maxVelocityDifference{10.0};
+    bool allowSelfIntersection{true};
+    double maxAngularDeviation{360.0};
+    double accountTurningCircleLength{5.0};
+    double maxSamplingPointSkippingDistance{3000.0};
+    Matcher::Routing::SamplingPointSkipStrategy samplingPointSkipStrategy{Matcher::Routing::SamplingPointSkipStrategy::excludeEdgeCosts};
+    double maxCandidateBacktrackingDistance{1000.0};
+    double maxClusteredRoutesLengthDifference{4.0 * GridTrack::searchRadius};
+    Matcher::Routing::RouteClusterPreference routeClusterPreference{Matcher::Routing::RouteClusterPreference::shortest};
+    size_t maxCandidatesPerSamplingPoint{0};
+};
+
+void requireSameRoutes(Types::Routing::RouteList const & routes1, Types::Routing::RouteList const & routes2)
+{
+    REQUIRE(routes1.size() == routes2.size());
+    for (size_t index = 0; index < routes1.size(); ++index)
+    {
+        REQUIRE(routes1[index]->source.samplingPoint == routes2[index]->source.samplingPoint);
+        REQUIRE(routes1[index]->target.samplingPoint == routes2[index]->target.samplingPoint);
+        REQUIRE(routes1[index]->length() == Approx(routes2[index]->length()));
+    }
+}
+
+}  // namespace
+
+SCENARIO("Tracks are matched in a batch like one by one", "[BatchRouter]")
+{
+    auto const grid = StreetGrid{5};
+    auto const tracks = std::vector<GridTrack>{
+        GridTrack{grid, {StreetGrid::junction(0, 0), StreetGrid::junction(4, 0), StreetGrid::junction(4, 4)}, 0.0003, 10.0},
+        GridTrack{grid, {StreetGrid::junction(0, 4), StreetGrid::junction(0, 1), StreetGrid::junction(3, 1)}, 0.0004, 12.0},
+        GridTrack{grid, {StreetGrid::junction(2, 0), StreetGrid::junction(2, 4)}, 0.0003, 8.0}};
+    auto const c = Configuration{};
+
+    auto batchTracks = std::vector<Matcher::BatchRouter::Track>{};
+    for (auto const & track : tracks)
+        batchTracks.push_back({track.samplingPointList, track.timeList, track.velocityList});
+
+    auto const pathCache = std::make_shared<Matcher::Routing::PathCache>();
+    auto const batchRouter = Matcher::BatchRouter{
+        c.maxVelocityDifference,
+        c.allowSelfIntersection,
+        c.maxAngularDeviation,
+        c.accountTurningCircleLength,
+        c.maxSamplingPointSkippingDistance,
+        c.samplingPointSkipStrategy,
+        c.maxCandidateBacktrackingDistance,
+        c.maxClusteredRoutesLengthDifference,
+        c.routeClusterPreference,
+        grid.segmentList,
+        2,
+        pathCache,
+        c.maxCandidatesPerSamplingPoint};
+    auto const results = batchRouter(batchTracks, grid.graph, grid.graphEdgeMap, grid.streetIndexMap);
+
+    THEN("each track gets the routes of the Router")
+    {
+        REQUIRE(results.size() == tracks.size());
+        for (size_t trackIndex = 0; trackIndex < tracks.size(); ++trackIndex)
+        {
+            auto const & track = tracks[trackIndex];
+            auto router = Matcher::Router{
+                c.maxVelocityDifference,
+                c.allowSelfIntersection,
+                c.maxAngularDeviation,
+                c.accountTurningCircleLength,
+                c.maxSamplingPointSkippingDistance,
+                c.samplingPointSkipStrategy,
+                c.maxCandidateBacktrackingDistance,
+                c.maxClusteredRoutesLengthDifference,
+                c.routeClusterPreference,
+                track.timeList,
+                track.velocityList,
+                grid.segmentList,
+                nullptr,
+                c.maxCandidatesPerSamplingPoint};
+            auto routeList = Types::Routing::RouteList{};
+            auto routingStatistic = Types::Routing::RoutingStatistic{};
+            router(track.samplingPointList, grid.graph, grid.graphEdgeMap, grid.streetIndexMap, routeList, routingStatistic);
+
+            REQUIRE(!routeList.empty());
+            requireSameRoutes(results[trackIndex].routeList, routeList);
+        }
+    }
+
+    THEN("a further batch on the same graph finds all paths in the shared cache")
+    {
+        auto const misses = pathCache->misses();
+        REQUIRE(misses > 0);
+        auto const repeatedResults = batchRouter(batchTracks, grid.graph, grid.graphEdgeMap, grid.streetIndexMap);
+        REQUIRE(pathCache->misses() == misses);
+        for (size_t trackIndex = 0; trackIndex < tracks.size(); ++trackIndex)
+            requireSameRoutes(repeatedResults[trackIndex].routeList, results[trackIndex].routeList);
+    }
+}
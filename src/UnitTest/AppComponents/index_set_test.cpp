@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Matcher/Routing/Generic/IndexSet.h>
+
+#include <catch2/catch.hpp>
+
+using namespace AppComponents::Common::Matcher::Routing::Generic;
+
+SCENARIO("Inserted indices are rolled back to a checkpoint", "[IndexSet]")
+{
+    GIVEN("a set with indices inserted before the checkpoint")
+    {
+        auto set = IndexSet{};
+        set.insert(1);
+        set.insert(70);
+
+        auto checkpoint = IndexSet::Checkpoint{set};
+        set.insert(2);
+        set.insert(70);
+        set.insert(130);
+        REQUIRE(set.contains(2));
+        REQUIRE(set.contains(130));
+
+        THEN("rollback removes only the indices inserted since")
+        {
+            checkpoint.rollback();
+            REQUIRE(set.contains(1));
+            REQUIRE(set.contains(70));
+            REQUIRE_FALSE(set.contains(2));
+            REQUIRE_FALSE(set.contains(130));
+        }
+
+        THEN("a nested checkpoint rolls back independently")
+        {
+            {
+                auto inner = IndexSet::Checkpoint{set};
+                set.insert(3);
+                inner.rollback();
+                REQUIRE_FALSE(set.contains(3));
+                REQUIRE(set.contains(2));
+            }
+            checkpoint.rollback();
+            REQUIRE_FALSE(set.contains(2));
+            REQUIRE(set.contains(70));
+        }
+    }
+}
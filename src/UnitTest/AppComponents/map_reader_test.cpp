@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "TemporaryFile.h"
+
+#include <AppComponents/Common/Reader/GeoJson/Conversion.h>
+#include <AppComponents/Common/Reader/GeoJsonMapReader.h>
+#include <AppComponents/Common/Reader/MappedGeoJsonMapReader.h>
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace AppComponents::Common;
+
+namespace {
+
+struct Map
+{
+    Types::Street::SegmentList segmentList;
+    Types::Street::NodePairList nodePairList;
+    Types::Street::TravelDirectionList travelDirectionList;
+    Types::Street::HighwayList highwayList;
+};
+
+Map readGeoJson(std::string const & content)
+{
+    auto input = std::istringstream{content};
+    auto map = Map{};
+    Reader::GeoJsonMapReader{input}(map.segmentList, map.nodePairList, map.travelDirectionList, map.highwayList);
+    return map;
+}
+
+Map readMappedGeoJson(std::string const & content, size_t const threadCount)
+{
+    auto const file = TemporaryFile{content};
+    auto map = Map{};
+    Reader::MappedGeoJsonMapReader{file.path(), threadCount}(map.segmentList, map.nodePairList, map.travelDirectionList, map.highwayList);
+    return map;
+}
+
+std::string feature(size_t const id, std::string const & travelDirection, std::string const & highway, std::string const & coordinates)
+{
+    return R"({"type": "Feature", "properties": {"Id": )" + std::to_string(id) + R"(, "Offset": 0, "SourceNode": )" + std::to_string(2 * id) + R"(, "TargetNode": )"
+        + std::to_string(2 * id + 1) + R"(, "TravelDirection": ")" + travelDirection + R"(", "Highway": ")" + highway + R"(", "Name": "[a] {b}"}, "geometry": {"type": "LineString", "coordinates": )"
+        + coordinates + "}}";
+}
+
+std::string featureCollection(std::string const & features)
+{
+    return R"({"type": "FeatureCollection", "crs": {"type": "name", "properties": {"name": "EPSG:4326"}}, "features": [)" + features + "]}";
+}
+
+}  // namespace
+
+SCENARIO("The mapped GeoJSON map reader reads like the stream based one", "[MapReader]")
+{
+    GIVEN("a feature collection")
+    {
+        auto features = std::string{};
+        for (size_t id = 0; id < 2500; ++id)
+        {
+            if (id > 0)
+                features += ",\n";
+            auto const lon = 13.0 + 0.001 * static_cast<double>(id);
+            features += feature(
+                id,
+                id % 3 == 0 ? "Both" : id % 3 == 1 ? "Forwards" : "Backwards",
+                id % 2 == 0 ? "Primary" : "Unknown",
+                "[[" + std::to_string(lon) + ", 52.5], [" + std::to_string(lon + 0.0005) + ", 52.5005], [" + std::to_string(lon + 0.001) + ", 52.5]]");
+        }
+        auto const content = featureCollection(features);
+
+        THEN("both return the same lists, on any number of threads")
+        {
+            auto const expected = readGeoJson(content);
+            REQUIRE(expected.segmentList.size() == 2500);
+            for (auto const threadCount : {1, 4})
+            {
+                auto const map = readMappedGeoJson(content, threadCount);
+                REQUIRE(map.segmentList.size() == expected.segmentList.size());
+                for (size_t index = 0; index < expected.segmentList.size(); ++index)
+                {
+                    REQUIRE(map.segmentList[index].originId == expected.segmentList[index].originId);
+                    REQUIRE(map.segmentList[index].originOffset == expected.segmentList[index].originOffset);
+                    REQUIRE(map.segmentList[index].geometry == expected.segmentList[index].geometry);
+                }
+                REQUIRE(map.nodePairList == expected.nodePairList);
+                REQUIRE(map.travelDirectionList == expected.travelDirectionList);
+                REQUIRE(map.highwayList == expected.highwayList);
+            }
+        }
+    }
+
+    GIVEN("features with invalid content")
+    {
+        THEN("both fail")
+        {
+            for (auto const & content : {
+                     featureCollection(feature(0, "Sideways", "Primary", "[[13.0, 52.5], [13.1, 52.5]]")),
+                     featureCollection(R"({"type": "Feature", "properties": {"Id": 0, "Offset": 0, "SourceNode": 0, "TargetNode": 1, "TravelDirection": "Both", "Highway": "Primary"},
+                                          "geometry": {"type": "Point", "coordinates": [13.0, 52.5]}})"),
+                     featureCollection(R"({"type": "Node", "properties": {}, "geometry": {}})")})
+            {
+                REQUIRE_THROWS(readGeoJson(content));
+                REQUIRE_THROWS(readMappedGeoJson(content, 1));
+            }
+        }
+    }
+
+    GIVEN("mismatched brackets in a skipped member")
+    {
+        auto const content = std::string{R"({"type": "FeatureCollection", "crs": {"properties": [1, 2}], "features": [)"}
+            + feature(0, "Both", "Primary", "[[13.0, 52.5], [13.1, 52.5]]") + "]}";
+
+        THEN("both fail")
+        {
+            REQUIRE_THROWS(readGeoJson(content));
+            REQUIRE_THROWS(readMappedGeoJson(content, 1));
+        }
+    }
+}
+
+SCENARIO("GeoJSON features are converted to street segments", "[MapReader]")
+{
+    GIVEN("a feature whose geometry is no line string")
+    {
+        auto const json = nlohmann::json::parse(feature(0, "Both", "Primary", "[[13.0, 52.5], [13.1, 52.5]]"));
+        auto pointFeature = json;
+        pointFeature["geometry"]["type"] = "Point";
+
+        THEN("it is rejected with a domain error")
+        {
+            REQUIRE(Reader::GeoJson::toFeature(json).segment.geometry.size() == 2);
+            REQUIRE_THROWS_AS(Reader::GeoJson::toFeature(pointFeature), std::domain_error);
+        }
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "StreetGrid.h"
+
+#include <AppComponents/Common/Matcher/OnlineRouter.h>
+#include <AppComponents/Common/Matcher/Routing/StreetLengthRouting.h>
+#include <AppComponents/Common/Matcher/Routing/ViterbiLattice.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using namespace AppComponents::Common;
+
+namespace {
+
+Matcher::OnlineRouter::Configuration makeConfiguration(double const maxWindowDistance)
+{
+    return {GridTrack::searchRadius, 90.0, 10.0, true, 360.0, 5.0, 5.0, 10.0, 20.0, 0, maxWindowDistance};
+}
+
+struct OnlineMatch
+{
+    Types::Routing::RouteList routeList;
+    size_t maxSamplingPointCount{0};
+    size_t maxTrackPointCount{0};
+};
+
+OnlineMatch matchOnline(StreetGrid const & grid, GridTrack const & track, double const maxWindowDistance)
+{
+    auto onlineRouter = Matcher::OnlineRouter{makeConfiguration(maxWindowDistance), grid.segmentList, grid.travelDirectionList, grid.graph, grid.graphEdgeMap, grid.streetIndexMap};
+    auto match = OnlineMatch{};
+    for (size_t trackIndex = 0; trackIndex < track.pointList.size(); ++trackIndex)
+    {
+        auto const update = onlineRouter({track.pointList[trackIndex], std::nullopt, track.timeList[trackIndex], track.velocityList[trackIndex]});
+        match.routeList.insert(match.routeList.end(), update.finalRoutes.begin(), update.finalRoutes.end());
+        match.maxSamplingPointCount = std::max(match.maxSamplingPointCount, onlineRouter.samplingPointList().size());
+        match.maxTrackPointCount = std::max(match.maxTrackPointCount, onlineRouter.timeList().size());
+        REQUIRE(onlineRouter.trackOffset() + onlineRouter.timeList().size() == trackIndex + 1);
+    }
+    auto const finalRoutes = onlineRouter.finish();
+    match.routeList.insert(match.routeList.end(), finalRoutes.begin(), finalRoutes.end());
+    CHECK(onlineRouter.samplingPointList().empty());
+    CHECK(onlineRouter.timeList().empty());
+    CHECK(onlineRouter.samplingPointOffset() == track.samplingPointList.size());
+    return match;
+}
+
+}  // namespace
+
+SCENARIO("The online router only keeps the points of its window", "[OnlineRouter]")
+{
+    GIVEN("a long track circling a block of a grid")
+    {
+        auto const grid = StreetGrid{4};
+        auto waypoints = std::vector<Core::Common::Geometry::Point>{StreetGrid::junction(0, 0)};
+        for (size_t lap = 0; lap < 5; ++lap)
+            for (auto const & waypoint : {StreetGrid::junction(3, 0), StreetGrid::junction(3, 3), StreetGrid::junction(0, 3), StreetGrid::junction(0, 0)})
+                waypoints.push_back(waypoint);
+        auto const track = GridTrack{grid, waypoints, 0.0003, 10.0};
+        REQUIRE(track.samplingPointList.size() > 150);
+
+        WHEN("only converged routes are final")
+        {
+            auto const match = matchOnline(grid, track, std::numeric_limits<double>::infinity());
+
+            THEN("the lists stay bounded")
+            {
+                CHECK(match.maxSamplingPointCount < 10);
+                CHECK(match.maxTrackPointCount < 10);
+            }
+
+            THEN("the routes are the routes of the whole track matched at once")
+            {
+                auto const streetLengthRouting = Matcher::Routing::StreetLengthRouting{
+                    {10.0, true, 360.0, 5.0},
+                    track.samplingPointList,
+                    grid.graph,
+                    grid.graphEdgeMap,
+                    grid.streetIndexMap,
+                    track.timeList,
+                    track.velocityList,
+                    grid.segmentList,
+                    nullptr,
+                    Types::Routing::makeArena()};
+                auto routeList = Types::Routing::RouteList{};
+                auto routingStatistic = Types::Routing::RoutingStatistic{};
+                Matcher::Routing::ViterbiLattice{streetLengthRouting.router(), {5.0, 10.0, 20.0, 0}, track.samplingPointList}(routeList, routingStatistic);
+
+                REQUIRE(match.routeList.size() == routeList.size());
+                for (size_t index = 0; index < routeList.size(); ++index)
+                {
+                    REQUIRE(match.routeList[index]->source.samplingPoint == routeList[index]->source.samplingPoint);
+                    REQUIRE(match.routeList[index]->target.samplingPoint == routeList[index]->target.samplingPoint);
+                    REQUIRE(match.routeList[index]->length() == Approx(routeList[index]->length()));
+                }
+            }
+        }
+
+        WHEN("routes further back than a short distance are final")
+        {
+            auto const match = matchOnline(grid, track, 150.0);
+
+            THEN("the lists stay bounded")
+            {
+                CHECK(match.maxSamplingPointCount < 10);
+                CHECK(match.maxTrackPointCount < 10);
+            }
+
+            THEN("the routes connect all sampling points")
+            {
+                REQUIRE(match.routeList.size() == track.samplingPointList.size() - 1);
+                for (size_t index = 0; index < match.routeList.size(); ++index)
+                {
+                    CHECK(match.routeList[index]->source.samplingPoint.index == index);
+                    CHECK(match.routeList[index]->target.samplingPoint.index == index + 1);
+                    if (index > 0)
+                        CHECK(match.routeList[index]->source.samplingPoint == match.routeList[index - 1]->target.samplingPoint);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Matcher/Routing/PathCache.h>
+
+#include <Core/Graph/Graph.h>
+
+#include <catch2/catch.hpp>
+
+#include <future>
+#include <vector>
+
+using namespace AppComponents::Common::Matcher::Routing;
+
+namespace {
+
+class NodeGraph : public Core::Graph::Graph
+{
+public:
+    Core::Graph::Node node(size_t const id) const { return newNode(id); }
+
+    Core::Graph::Node createNode() override { return newNode(0); }
+    void remove(Core::Graph::Node) override {}
+    Core::Graph::Edge addEdge(Core::Graph::Node, Core::Graph::Node) override { return newEdge(0); }
+    void remove(Core::Graph::Edge) override {}
+    bool has(Core::Graph::Node) const override { return true; }
+    bool has(Core::Graph::Edge) const override { return false; }
+    Core::Graph::Node source(Core::Graph::Edge) const override { return newNode(0); }
+    Core::Graph::Node target(Core::Graph::Edge) const override { return newNode(0); }
+    std::vector<Core::Graph::Edge> outEdges(Core::Graph::Node) const override { return {}; }
+    std::vector<Core::Graph::Edge> inEdges(Core::Graph::Node) const override { return {}; }
+};
+
+}  // namespace
+
+SCENARIO("Paths are cached least-recently-used first", "[PathCache]")
+{
+    auto const graph = NodeGraph{};
+    auto key = [&](size_t const source, size_t const target) { return PathCache::Key{&graph, graph.node(source), graph.node(target), PathCache::CostProfile::geoDistance}; };
+    auto const path = std::make_shared<PathCache::Path const>();
+
+    GIVEN("a full cache")
+    {
+        auto cache = PathCache{2};
+        cache.insert(key(0, 1), path);
+        cache.insert(key(0, 2), path);
+        REQUIRE(cache.size() == 2);
+
+        THEN("inserting evicts the least recently used path")
+        {
+            cache.insert(key(0, 3), path);
+            REQUIRE(cache.size() == 2);
+            REQUIRE(cache.find(key(0, 1)) == nullptr);
+            REQUIRE(cache.find(key(0, 2)) == path);
+            REQUIRE(cache.find(key(0, 3)) == path);
+        }
+
+        THEN("finding a path makes it the most recently used one")
+        {
+            REQUIRE(cache.find(key(0, 1)) == path);
+            cache.insert(key(0, 3), path);
+            REQUIRE(cache.find(key(0, 1)) == path);
+            REQUIRE(cache.find(key(0, 2)) == nullptr);
+        }
+
+        THEN("replacing a path makes it the most recently used one")
+        {
+            auto const otherPath = std::make_shared<PathCache::Path const>();
+            cache.insert(key(0, 1), otherPath);
+            cache.insert(key(0, 3), path);
+            REQUIRE(cache.find(key(0, 1)) == otherPath);
+            REQUIRE(cache.find(key(0, 2)) == nullptr);
+        }
+    }
+
+    GIVEN("a cache with zero capacity")
+    {
+        auto cache = PathCache{0};
+        cache.insert(key(0, 1), path);
+
+        THEN("nothing is cached")
+        {
+            REQUIRE(cache.size() == 0);
+            REQUIRE(cache.find(key(0, 1)) == nullptr);
+        }
+    }
+}
+
+SCENARIO("Path cache hits and misses are counted", "[PathCache]")
+{
+    auto const graph = NodeGraph{};
+    auto const otherGraph = NodeGraph{};
+    auto cache = PathCache{};
+    auto const key = PathCache::Key{&graph, graph.node(0), graph.node(1), PathCache::CostProfile::geoDistance};
+    cache.insert(key, std::make_shared<PathCache::Path const>());
+
+    REQUIRE(cache.find(key) != nullptr);
+    REQUIRE(cache.find({&graph, graph.node(1), graph.node(0), PathCache::CostProfile::geoDistance}) == nullptr);
+    REQUIRE(cache.find({&otherGraph, graph.node(0), graph.node(1), PathCache::CostProfile::geoDistance}) == nullptr);
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.misses() == 2);
+
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.hits() == 0);
+    REQUIRE(cache.misses() == 0);
+}
+
+SCENARIO("A path cache is shared between threads", "[PathCache]")
+{
+    auto const graph = NodeGraph{};
+    auto cache = PathCache{64};
+    auto const path = std::make_shared<PathCache::Path const>();
+
+    constexpr size_t threadCount = 4;
+    constexpr size_t lookupCount = 1000;
+    auto workers = std::vector<std::future<void>>{};
+    for (size_t thread = 0; thread < threadCount; ++thread)
+        workers.push_back(std::async(
+            std::launch::async,
+            [&]
+            {
+                for (size_t lookup = 0; lookup < lookupCount; ++lookup)
+                {
+                    auto const key = PathCache::Key{&graph, graph.node(0), graph.node(lookup % 100), PathCache::CostProfile::geoDistance};
+                    if (!cache.find(key))
+                        cache.insert(key, path);
+                }
+            }));
+    for (auto & worker : workers)
+        worker.get();
+
+    REQUIRE(cache.size() == 64);
+    REQUIRE(cache.hits() + cache.misses() == threadCount * lookupCount);
+}
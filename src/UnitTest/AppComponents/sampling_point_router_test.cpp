@@ -0,0 +1,211 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "StreetGrid.h"
+
+#include <AppComponents/Common/Matcher/Routing/Comparators.h>
+#include <AppComponents/Common/Matcher/Routing/RouteJournal.h>
+#include <AppComponents/Common/Matcher/Routing/SamplingPointRouter.h>
+
+#include <Core/Common/Geometry/Helper.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace AppComponents::Common;
+using namespace AppComponents::Common::Matcher::Routing;
+
+namespace {
+
+using RoutePtr = std::shared_ptr<Types::Routing::Route>;
+
+/**
+ * Clusters routes in the given order like the `SamplingPointRouter` and returns the best role model.
+ */
+RoutePtr clusterAndSelect(std::vector<RoutePtr> const & routes, RouteClusterPreference const preference, double const maxLengthDifference, Types::Graph::GraphEdgeMap const & graphEdgeMap)
+{
+    auto clusters = std::vector<std::set<RoutePtr, BestSimilarRouteComparator>>{};
+    for (auto const & route : routes)
+    {
+        auto cluster = std::find_if(clusters.begin(), clusters.end(), [&](auto const & cluster) { return isSimilar(*route, **cluster.begin(), maxLengthDifference, graphEdgeMap); });
+        if (cluster == clusters.end())
+            cluster = clusters.emplace(clusters.end());
+        cluster->insert(route);
+    }
+    if (clusters.empty())
+        return nullptr;
+    auto const comparator = BestRouteComparator{preference};
+    return *std::min_element(clusters.begin(), clusters.end(), [&](auto const & a, auto const & b) { return comparator(*a.begin(), *b.begin()); })->begin();
+}
+
+/**
+ * Routes the candidate pairs from sampling point \p source to the next one, best-first or source candidate by source candidate.
+ * Pairs of two-way candidates are routed in all four direction variants, other pairs only in their travel direction.
+ */
+std::vector<RoutePtr> routeCandidatePairs(
+    DirectedCandidateRouter const & router, Types::Routing::SamplingPointList const & samplingPointList, size_t const source, size_t const maxCandidates, bool const bestFirst)
+{
+    auto candidateCount = [&](size_t const samplingPoint)
+    {
+        auto const count = samplingPointList[samplingPoint].candidates.size();
+        return maxCandidates == 0 ? count : std::min(count, maxCandidates);
+    };
+    auto const sourceCount = candidateCount(source);
+    auto const targetCount = candidateCount(source + 1);
+
+    auto routes = std::vector<RoutePtr>{};
+    auto routePair = [&](size_t const sourceRank, size_t const targetRank)
+    {
+        auto const sourceDirection = samplingPointList[source].candidates[sourceRank].streetSegmentTravelDirection;
+        auto const targetDirection = samplingPointList[source + 1].candidates[targetRank].streetSegmentTravelDirection;
+        auto const directions = sourceDirection == Types::Street::TravelDirection::both && targetDirection == Types::Street::TravelDirection::both
+            ? std::vector<std::pair<bool, bool>>{{true, true}, {false, false}, {true, false}, {false, true}}
+            : std::vector<std::pair<bool, bool>>{{sourceDirection == Types::Street::TravelDirection::forwards, targetDirection == Types::Street::TravelDirection::forwards}};
+        for (auto const & [sourceForwards, targetForwards] : directions)
+        {
+            auto const route = router({{source, {sourceRank, sourceForwards}}, {source + 1, {targetRank, targetForwards}}});
+            if (!route->subRoutes.empty())
+                routes.push_back(route);
+        }
+    };
+    if (bestFirst)
+    {
+        for (size_t diagonal = 0; diagonal + 1 < sourceCount + targetCount; ++diagonal)
+            for (size_t sourceRank = 0; sourceRank < sourceCount; ++sourceRank)
+                if (diagonal >= sourceRank && diagonal - sourceRank < targetCount)
+                    routePair(sourceRank, diagonal - sourceRank);
+    }
+    else
+    {
+        for (size_t sourceRank = 0; sourceRank < sourceCount; ++sourceRank)
+            for (size_t targetRank = 0; targetRank < targetCount; ++targetRank)
+                routePair(sourceRank, targetRank);
+    }
+    return routes;
+}
+
+/**
+ * A candidate heading east on the streets along the first row of \p grid.
+ * @param meters Distance from the first junction.
+ */
+Types::Routing::SamplingPointCandidate candidateOnFirstRow(StreetGrid const & grid, double const meters)
+{
+    auto const streetLength = Core::Common::Geometry::geoDistance(StreetGrid::junction(0, 0), StreetGrid::junction(1, 0));
+    auto const column = static_cast<size_t>(meters / streetLength);
+    auto const normLength = meters / streetLength - static_cast<double>(column);
+    // The street from each junction of a row to the next is followed by the one to the next row.
+    auto const streetIndex = 2 * column;
+    auto const & geometry = grid.segmentList[streetIndex].geometry;
+    auto const projectedPoint = Core::Common::Geometry::Point{
+        Core::Common::Geometry::Point::Longitude{geometry.front().lon() + normLength * (geometry.back().lon() - geometry.front().lon())},
+        Core::Common::Geometry::Point::Latitude{geometry.front().lat()}};
+    return {streetIndex, 0, projectedPoint, normLength, 0.0, 90.0, 0.0, Types::Street::TravelDirection::forwards};
+}
+
+std::shared_ptr<Types::Routing::Route> routeSamplingPoints(
+    DirectedCandidateRouter const & router, SamplingPointRouter::Configuration const & configuration, Types::Routing::SamplingPointList const & samplingPointList, Types::Graph::GraphEdgeMap const & graphEdgeMap, size_t const source)
+{
+    auto routeList = Types::Routing::RouteList{};
+    auto const journal = RouteJournal{routeList};
+    auto visitedRouteSet = SamplingPointRouter::VisitedRouteSet{};
+    auto routeMap = SamplingPointRouter::RouteMap{};
+    auto routingStatistic = Types::Routing::RoutingStatistic{};
+    return SamplingPointRouter{router, configuration, samplingPointList, graphEdgeMap}(source, source + 1, journal, visitedRouteSet, routeMap, routingStatistic);
+}
+
+}  // namespace
+
+SCENARIO("Candidate pairs are clustered in the order they are routed", "[SamplingPointRouter]")
+{
+    auto requireSameRoute = [](RoutePtr const & route, RoutePtr const & expected)
+    {
+        REQUIRE(route);
+        REQUIRE(expected);
+        REQUIRE(route->source.samplingPoint == expected->source.samplingPoint);
+        REQUIRE(route->target.samplingPoint == expected->target.samplingPoint);
+        REQUIRE(route->length() == Approx(expected->length()));
+    };
+
+    GIVEN("a track along the streets of a grid")
+    {
+        auto const grid = StreetGrid{4};
+        auto const track = GridTrack{grid, {StreetGrid::junction(0, 0), StreetGrid::junction(3, 0), StreetGrid::junction(3, 3), StreetGrid::junction(0, 3)}, 0.0003, 10.0};
+        auto const streetLengthRouting = grid.makeRouting(track.samplingPointList);
+        auto const & router = streetLengthRouting.router();
+
+        THEN("preferring the shortest route, each route is the best role model of the clusters founded in rank sum order")
+        {
+            for (size_t const maxCandidates : {0, 2})
+                for (auto const maxLengthDifference : {5.0, 60.0, 300.0})
+                    for (size_t source = 0; source + 1 < track.samplingPointList.size(); ++source)
+                        requireSameRoute(
+                            routeSamplingPoints(router, {maxLengthDifference, RouteClusterPreference::shortest, maxCandidates}, track.samplingPointList, grid.graphEdgeMap, source),
+                            clusterAndSelect(
+                                routeCandidatePairs(router, track.samplingPointList, source, maxCandidates, true), RouteClusterPreference::shortest, maxLengthDifference, grid.graphEdgeMap));
+        }
+        THEN("preferring the cheapest route, each route is the best role model of the clusters founded source candidate by source candidate")
+        {
+            for (size_t const maxCandidates : {0, 2})
+                for (auto const maxLengthDifference : {5.0, 60.0, 300.0})
+                    for (size_t source = 0; source + 1 < track.samplingPointList.size(); ++source)
+                        requireSameRoute(
+                            routeSamplingPoints(router, {maxLengthDifference, RouteClusterPreference::cheapest, maxCandidates}, track.samplingPointList, grid.graphEdgeMap, source),
+                            clusterAndSelect(
+                                routeCandidatePairs(router, track.samplingPointList, source, maxCandidates, false), RouteClusterPreference::cheapest, maxLengthDifference, grid.graphEdgeMap));
+        }
+    }
+    GIVEN("candidates along a straight street whose routes are only similar to routes of neighbouring length")
+    {
+        auto const grid = StreetGrid{5};
+        // The routes from the source to the target candidates are between 50 m and 365 m long,
+        // so which of them are clustered depends on the order they are clustered in.
+        auto samplingPointList = Types::Routing::SamplingPointList{{0, {candidateOnFirstRow(grid, 10.0), candidateOnFirstRow(grid, 85.0)}}, {1, {}}};
+        for (auto const meters : {275.0, 375.0, 175.0, 135.0})
+            samplingPointList[1].candidates.push_back(candidateOnFirstRow(grid, meters));
+        auto const streetLengthRouting = grid.makeRouting(samplingPointList);
+        auto const & router = streetLengthRouting.router();
+        constexpr double maxLengthDifference = 50.0;
+
+        auto const bestFirst = clusterAndSelect(routeCandidatePairs(router, samplingPointList, 0, 0, true), RouteClusterPreference::cheapest, maxLengthDifference, grid.graphEdgeMap);
+        auto const sourceBySource
+            = clusterAndSelect(routeCandidatePairs(router, samplingPointList, 0, 0, false), RouteClusterPreference::cheapest, maxLengthDifference, grid.graphEdgeMap);
+        REQUIRE(bestFirst);
+        REQUIRE(sourceBySource);
+        REQUIRE_FALSE(bestFirst->target.samplingPoint == sourceBySource->target.samplingPoint);
+
+        THEN("preferring the cheapest route, the route is the best role model of the clusters founded source candidate by source candidate")
+        {
+            requireSameRoute(routeSamplingPoints(router, {maxLengthDifference, RouteClusterPreference::cheapest, 0}, samplingPointList, grid.graphEdgeMap, 0), sourceBySource);
+        }
+    }
+}
+
+SCENARIO("Sampling points without candidates are not routed", "[SamplingPointRouter]")
+{
+    GIVEN("a track whose second sampling point lost its candidates")
+    {
+        auto const grid = StreetGrid{2};
+        auto const track = GridTrack{grid, {StreetGrid::junction(0, 0), StreetGrid::junction(1, 0)}, 0.0003, 10.0};
+        auto samplingPointList = track.samplingPointList;
+        REQUIRE(samplingPointList.size() >= 2);
+        samplingPointList[1].candidates.clear();
+        auto const streetLengthRouting = grid.makeRouting(samplingPointList);
+
+        THEN("no route is found into or out of it")
+        {
+            for (auto const preference : {RouteClusterPreference::shortest, RouteClusterPreference::cheapest})
+            {
+                CHECK_FALSE(routeSamplingPoints(streetLengthRouting.router(), {60.0, preference, 0}, samplingPointList, grid.graphEdgeMap, 0));
+                CHECK_FALSE(routeSamplingPoints(streetLengthRouting.router(), {60.0, preference, 0}, samplingPointList, grid.graphEdgeMap, 1));
+            }
+        }
+    }
+}
@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Matcher/SamplingPointFinder.h>
+#include <AppComponents/Common/Writer/GeoJsonMapWriter.h>
+
+#include <Core/Common/Geometry/PackedLineStrings.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <sstream>
+
+using namespace AppComponents::Common;
+using Core::Common::Geometry::Point;
+
+namespace {
+
+/// Streets with up to 6 points around Berlin, their coordinates have 7 decimal places like the ones of OSM.
+struct E7Map
+{
+    explicit E7Map(size_t const streetCount)
+    {
+        auto random = std::mt19937{42};
+        // About 1.5 km, so the streets overlap and cross.
+        auto offsetDistribution = std::uniform_int_distribution<std::int32_t>{0, 200'000};
+        auto stepDistribution = std::uniform_int_distribution<std::int32_t>{-5'000, 5'000};
+        auto pointCountDistribution = std::uniform_int_distribution<size_t>{2, 6};
+        auto travelDirectionDistribution = std::uniform_int_distribution<int>{0, 2};
+        for (size_t street = 0; street < streetCount; ++street)
+        {
+            auto point = Core::Common::Geometry::PackedPoint{134'000'000 + offsetDistribution(random), 525'000'000 + offsetDistribution(random)};
+            auto geometry = Core::Common::Geometry::LineString{};
+            for (auto pointCount = pointCountDistribution(random); geometry.size() < pointCount;)
+            {
+                geometry.push_back(Core::Common::Geometry::unpack(point));
+                point.lon += stepDistribution(random);
+                point.lat += stepDistribution(random);
+            }
+            segmentList.push_back({street, 0, geometry});
+            nodePairList.emplace_back(2 * street, 2 * street + 1);
+            travelDirectionList.push_back(static_cast<Types::Street::TravelDirection>(travelDirectionDistribution(random)));
+            highwayList.push_back(Types::Street::HighwayType::primary);
+        }
+    }
+
+    Types::Street::SegmentList segmentList;
+    Types::Street::NodePairList nodePairList;
+    Types::Street::TravelDirectionList travelDirectionList;
+    Types::Street::HighwayList highwayList;
+};
+
+bool isSameCandidate(Types::Routing::SamplingPointCandidate const & a, Types::Routing::SamplingPointCandidate const & b)
+{
+    return a.streetIndex == b.streetIndex && a.streetSegmentIndex == b.streetSegmentIndex && a.streetSegmentProjectedPoint.lon() == b.streetSegmentProjectedPoint.lon()
+        && a.streetSegmentProjectedPoint.lat() == b.streetSegmentProjectedPoint.lat() && a.streetSegmentProjectedPointNormLength == b.streetSegmentProjectedPointNormLength
+        && a.streetSegmentDistance == b.streetSegmentDistance && a.streetSegmentHeading == b.streetSegmentHeading
+        && a.streetSegmentHeadingDifference == b.streetSegmentHeadingDifference && a.streetSegmentTravelDirection == b.streetSegmentTravelDirection;
+}
+
+}  // namespace
+
+SCENARIO("The compact street geometries do not change the results for E7 maps", "[segment_geometry_list]")
+{
+    GIVEN("A map with 7 decimal places, its compact geometries and a track across it")
+    {
+        auto const map = E7Map{500};
+        auto const segmentGeometryList = Types::Street::toSegmentGeometryList(map.segmentList);
+
+        auto random = std::mt19937{7};
+        auto coordinateDistribution = std::uniform_real_distribution<double>{0.0, 0.02};
+        auto headingDistribution = std::uniform_real_distribution<double>{0.0, 360.0};
+        auto pointList = Types::Track::PointList{};
+        auto headingList = Types::Track::HeadingList{};
+        for (size_t index = 0; index < 1000; ++index)
+        {
+            pointList.push_back(Point{Point::Longitude{13.4 + coordinateDistribution(random)}, Point::Latitude{52.5 + coordinateDistribution(random)}});
+            headingList.push_back(headingDistribution(random));
+        }
+
+        THEN("the compact geometries hold the same points")
+        {
+            REQUIRE(segmentGeometryList.size() == map.segmentList.size());
+            for (size_t street = 0; street < map.segmentList.size(); ++street)
+            {
+                auto const & geometry = map.segmentList[street].geometry;
+                auto const view = segmentGeometryList[street];
+                REQUIRE(view.size() == geometry.size());
+                for (size_t index = 0; index < geometry.size(); ++index)
+                {
+                    REQUIRE(view[index].lon() == geometry[index].lon());
+                    REQUIRE(view[index].lat() == geometry[index].lat());
+                }
+            }
+        }
+        THEN("the same candidates are found on them")
+        {
+            auto samplingPointList = Types::Routing::SamplingPointList{};
+            Matcher::SamplingPointFinder{
+                Matcher::SamplingPointFinder::SelectionStrategy::all, 30.0, 90.0, pointList, headingList, map.segmentList, map.travelDirectionList}(samplingPointList);
+            auto packedSamplingPointList = Types::Routing::SamplingPointList{};
+            Matcher::SamplingPointFinder{
+                Matcher::SamplingPointFinder::SelectionStrategy::all,
+                30.0,
+                90.0,
+                pointList,
+                headingList,
+                map.segmentList,
+                map.travelDirectionList,
+                &segmentGeometryList}(packedSamplingPointList);
+
+            // Most track points lie near some street.
+            REQUIRE(samplingPointList.size() > pointList.size() / 2);
+            REQUIRE(packedSamplingPointList.size() == samplingPointList.size());
+            for (size_t index = 0; index < samplingPointList.size(); ++index)
+            {
+                REQUIRE(packedSamplingPointList[index].trackIndex == samplingPointList[index].trackIndex);
+                auto const & candidates = samplingPointList[index].candidates;
+                auto const & packedCandidates = packedSamplingPointList[index].candidates;
+                REQUIRE(std::equal(packedCandidates.begin(), packedCandidates.end(), candidates.begin(), candidates.end(), isSameCandidate));
+            }
+        }
+        THEN("the same map is written from them")
+        {
+            auto output = std::ostringstream{};
+            Writer::GeoJsonMapWriter{output}(map.segmentList, map.nodePairList, map.travelDirectionList, map.highwayList);
+            auto packedOutput = std::ostringstream{};
+            Writer::GeoJsonMapWriter{packedOutput, &segmentGeometryList}(map.segmentList, map.nodePairList, map.travelDirectionList, map.highwayList);
+
+            REQUIRE(packedOutput.str() == output.str());
+        }
+    }
+}
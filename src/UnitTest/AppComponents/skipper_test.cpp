@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <UnitTest/Helpers.h>
+
+#include <AppComponents/Common/Matcher/Routing/Generic/Skipper.h>
+
+#include <Core/Common/Geometry/Helper.h>
+
+#include <catch2/catch.hpp>
+
+using namespace AppComponents::Common::Matcher::Routing::Generic;
+using namespace Core::Common::Geometry;
+
+SCENARIO("Sampling points are skipped within a direct distance", "[Skipper]")
+{
+    // Sampling points 3 and 5 are detours north of the others, which lie on the equator 111 m apart.
+    auto const locations = Skipper::LocationList{
+        Point{-0.002_lon, 0.0_lat},
+        Point{0.001_lon, 0.0_lat},
+        Point{0.002_lon, 0.0_lat},
+        Point{0.0025_lon, 0.01_lat},
+        Point{0.003_lon, 0.0_lat},
+        Point{0.0035_lon, 0.01_lat},
+        Point{0.004_lon, 0.0_lat}};
+    auto const step = geoDistance(locations[1], locations[2]);
+
+    GIVEN("A blocklisted detour between the target and the next sampling point")
+    {
+        auto blocklist = IndexSet{};
+        blocklist.insert(3);
+        auto skipper = Skipper{1, 2, 0, 4, blocklist, locations, 1.5 * step, Skipper::Strategy::includeEdgeCosts};
+
+        THEN("the detour does not count")
+        {
+            REQUIRE(skipper.next());
+            REQUIRE(skipper.source() == 1);
+            REQUIRE(skipper.target() == 4);
+            REQUIRE(skipper.cost() == Approx(step));
+            REQUIRE(skipper.skipped() == std::vector<size_t>{2});
+        }
+        THEN("skipping stops at the cost limit")
+        {
+            REQUIRE(skipper.next());
+            REQUIRE_FALSE(skipper.next());
+        }
+    }
+
+    GIVEN("A detour which is not blocklisted")
+    {
+        auto const noBlocklist = IndexSet{};
+        auto skipper = Skipper{1, 4, 0, 6, noBlocklist, locations, 1.5 * step, Skipper::Strategy::includeEdgeCosts};
+
+        THEN("it is too far away to be skipped to")
+        {
+            REQUIRE_FALSE(skipper.next());
+        }
+    }
+}
@@ -0,0 +1,191 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "TemporaryFile.h"
+
+#include <AppComponents/Common/Reader/CsvTrackReader.h>
+#include <AppComponents/Common/Reader/JsonTrackReader.h>
+#include <AppComponents/Common/Reader/MappedCsvTrackReader.h>
+
+#include <Core/Common/Time/Helper.h>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+using namespace AppComponents::Common;
+
+namespace {
+
+struct Track
+{
+    Types::Track::TimeList timeList;
+    Types::Track::PointList pointList;
+    Types::Track::HeadingList headingList;
+    Types::Track::VelocityList velocityList;
+};
+
+Track readCsv(std::string const & content)
+{
+    auto input = std::istringstream{content};
+    auto track = Track{};
+    Reader::CsvTrackReader{input}(track.timeList, track.pointList, track.headingList, track.velocityList);
+    return track;
+}
+
+Track readMappedCsv(std::string const & content)
+{
+    auto const file = TemporaryFile{content};
+    auto track = Track{};
+    Reader::MappedCsvTrackReader{file.path()}(track.timeList, track.pointList, track.headingList, track.velocityList);
+    return track;
+}
+
+Track readJson(std::string const & content)
+{
+    auto input = std::istringstream{content};
+    auto track = Track{};
+    Reader::JsonTrackReader{input}(track.timeList, track.pointList, track.headingList, track.velocityList);
+    return track;
+}
+
+void requireSameTrack(Track const & track1, Track const & track2)
+{
+    REQUIRE(track1.timeList == track2.timeList);
+    REQUIRE(track1.pointList == track2.pointList);
+    REQUIRE(track1.headingList == track2.headingList);
+    REQUIRE(track1.velocityList == track2.velocityList);
+}
+
+}  // namespace
+
+SCENARIO("The mapped CSV track reader reads like the stream based one", "[TrackReader]")
+{
+    auto requireSameAsStreamReader = [](std::string const & content, size_t const rowCount)
+    {
+        auto const track = readMappedCsv(content);
+        REQUIRE(track.timeList.size() == rowCount);
+        requireSameTrack(track, readCsv(content));
+    };
+
+    GIVEN("plain rows")
+    {
+        auto const content = std::string{
+            "2018-06-22T03:14:10;52.51;13.37;90.5;10.25\n"
+            "2018-06-22T03:14:11;52.52;13.38;-45;+1e1\n"};
+        THEN("both read all rows") { requireSameAsStreamReader(content, 2); }
+    }
+
+    GIVEN("rows with padded cells")
+    {
+        auto const content = std::string{
+            "  2018-06-22T03:14:10 ; 52.51;13.37 ;\t90.5\t;  10.25  \n"
+            "2018-06-22T03:14:11.500;52.52  ;  13.38;45;11\n"};
+        THEN("both trim the cells") { requireSameAsStreamReader(content, 2); }
+    }
+
+    GIVEN("rows with CRLF line endings")
+    {
+        auto const content = std::string{
+            "2018-06-22T03:14:10;52.51;13.37;90.5;10.25\r\n"
+            "2018-06-22T03:14:11;52.52;13.38;45;11\r\n"};
+        THEN("both ignore the carriage returns") { requireSameAsStreamReader(content, 2); }
+    }
+
+    GIVEN("rows with extra columns")
+    {
+        auto const content = std::string{
+            "2018-06-22T03:14:10;52.51;13.37;90.5;10.25;extra;columns\n"
+            "2018-06-22T03:14:11;52.52;13.38;45;11;\n"
+            "2018-06-22T03:14:12;52.53;13.39;46;12"};
+        THEN("both ignore the extra columns") { requireSameAsStreamReader(content, 3); }
+    }
+
+    GIVEN("a row with too few columns")
+    {
+        auto const content = std::string{
+            "2018-06-22T03:14:10;52.51;13.37;90.5;10.25\r\n"
+            "\r\n"
+            "2018-06-22T03:14:11;52.52;13.38;45;11\r\n"};
+        THEN("both stop reading there") { requireSameAsStreamReader(content, 1); }
+    }
+}
+
+SCENARIO("The JSON track reader collects the track points while parsing", "[TrackReader]")
+{
+    GIVEN("a valid track")
+    {
+        auto const track = readJson(R"([
+            {"pos_time": "2018-06-22T03:14:10Z", "latitude": 52.51, "longitude": 13.37, "course": 90, "speed": 36},
+            {"speed": 18.0, "longitude": 13.38, "latitude": 52.52, "pos_time": "2018-06-22T03:14:11Z"}
+        ])");
+
+        THEN("all track points are read")
+        {
+            REQUIRE(track.timeList.size() == 2);
+            CHECK(track.timeList[0] == Core::Common::Time::fromIsoZString("2018-06-22T03:14:10Z").first);
+            CHECK(track.timeList[1] == Core::Common::Time::fromIsoZString("2018-06-22T03:14:11Z").first);
+            CHECK(track.pointList[0].lat() == 52.51);
+            CHECK(track.pointList[0].lon() == 13.37);
+            CHECK(track.pointList[1].lat() == 52.52);
+            CHECK(track.pointList[1].lon() == 13.38);
+            CHECK(track.headingList[0] == 90.0);
+            CHECK(std::isnan(track.headingList[1]));
+            CHECK(track.velocityList[0] == Approx(10.0));
+            CHECK(track.velocityList[1] == Approx(5.0));
+        }
+    }
+
+    GIVEN("a track with unknown keys holding nested values")
+    {
+        auto const track = readJson(R"([
+            {"pos_time": "2018-06-22T03:14:10Z", "id": "a", "valid": true, "note": null,
+             "raw": {"latitude": "x", "speed": [1, 2, {"pos_time": 3}]}, "history": [[{"longitude": false}]],
+             "latitude": 52.51, "longitude": 13.37, "speed": 36}
+        ])");
+
+        THEN("the unknown keys are skipped")
+        {
+            REQUIRE(track.timeList.size() == 1);
+            CHECK(track.pointList[0].lat() == 52.51);
+            CHECK(track.pointList[0].lon() == 13.37);
+            CHECK(track.velocityList[0] == Approx(10.0));
+        }
+    }
+
+    GIVEN("content following the track")
+    {
+        auto const track = readJson(R"([{"pos_time": "2018-06-22T03:14:10Z", "latitude": 52.51, "longitude": 13.37, "speed": 36}] trailing)");
+
+        THEN("it is ignored") { CHECK(track.timeList.size() == 1); }
+    }
+
+    GIVEN("a track point lacking a field")
+    {
+        auto const content = std::string{R"([{"pos_time": "2018-06-22T03:14:10Z", "latitude": 52.51, "speed": 36}])"};
+
+        THEN("reading fails") { REQUIRE_THROWS(readJson(content)); }
+    }
+
+    GIVEN("a track point with a field of the wrong type")
+    {
+        auto const content = std::string{R"([{"pos_time": "2018-06-22T03:14:10Z", "latitude": "52.51", "longitude": 13.37, "speed": 36}])"};
+
+        THEN("reading fails") { REQUIRE_THROWS(readJson(content)); }
+    }
+
+    GIVEN("a track which is no array of objects")
+    {
+        THEN("reading fails")
+        {
+            REQUIRE_THROWS(readJson(R"({"pos_time": "2018-06-22T03:14:10Z"})"));
+            REQUIRE_THROWS(readJson(R"([[1, 2]])"));
+            REQUIRE_THROWS(readJson(R"([{"pos_time": "2018-06-22T03:14:10Z", "latitude": 52.51)"));
+        }
+    }
+}
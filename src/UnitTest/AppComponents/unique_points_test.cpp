@@ -0,0 +1,205 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <AppComponents/Common/Reader/Osm/UniquePoints.h>
+
+#include <Core/Common/Geometry/Helper.h>
+#include <Core/Common/Geometry/NumericConstants.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace AppComponents::Common::Reader::Osm;
+using Core::Common::Geometry::Point;
+
+namespace {
+
+constexpr double metersPerDegree = Core::Common::Geometry::equatorRadiusMeter * Core::Common::Geometry::piover180;
+
+/// Merges each coordinate into the nearest of all preceding unique points within the merge distance.
+UniquePoints mergeSequentially(std::vector<Point> const & coordinates)
+{
+    auto result = UniquePoints{std::vector<size_t>(coordinates.size()), std::vector<UniquePoint>(coordinates.size()), 0};
+    auto firstCoordinates = std::vector<size_t>{};
+    for (size_t coordinate = 0; coordinate < coordinates.size(); ++coordinate)
+    {
+        auto nearest = coordinate;
+        auto nearestDistance = maxMergeDistanceInMeters;
+        for (auto const firstCoordinate : firstCoordinates)
+        {
+            auto const distance = Core::Common::Geometry::geoDistance(coordinates[firstCoordinate], coordinates[coordinate]);
+            if (distance <= nearestDistance)
+            {
+                nearest = firstCoordinate;
+                nearestDistance = distance;
+            }
+        }
+        if (nearest == coordinate)
+            firstCoordinates.push_back(coordinate);
+        result.ofCoordinate[coordinate] = nearest;
+        result.points[nearest].id = coordinate;
+        ++result.points[nearest].coordinateCount;
+    }
+    result.count = firstCoordinates.size();
+    return result;
+}
+
+/// { unique point, its id, its coordinate count } of each coordinate.
+std::vector<std::tuple<size_t, size_t, size_t>> describe(UniquePoints const & uniquePoints)
+{
+    auto description = std::vector<std::tuple<size_t, size_t, size_t>>{};
+    for (auto const uniquePoint : uniquePoints.ofCoordinate)
+        description.emplace_back(uniquePoint, uniquePoints.points[uniquePoint].id, uniquePoints.points[uniquePoint].coordinateCount);
+    return description;
+}
+
+Point offset(Point const & point, double const eastMeters, double const northMeters)
+{
+    auto const lonMeters = metersPerDegree * std::cos(point.lat() * Core::Common::Geometry::piover180);
+    return Point{Point::Longitude{point.lon() + eastMeters / lonMeters}, Point::Latitude{point.lat() + northMeters / metersPerDegree}};
+}
+
+/**
+ * Junctions of 1 to 6 coordinates up to 8cm apart in each direction, some of which are merged and some not,
+ * scattered over 1km around \p center, so many of them straddle cell rows and columns.
+ */
+std::vector<Point> junctions(Point const & center, size_t const junctionCount, std::mt19937 & random)
+{
+    auto positionDistribution = std::uniform_real_distribution<double>{-500.0, 500.0};
+    auto offsetDistribution = std::uniform_real_distribution<double>{-0.08, 0.08};
+    auto coordinateCountDistribution = std::uniform_int_distribution<size_t>{1, 6};
+    auto coordinates = std::vector<Point>{};
+    for (size_t junction = 0; junction < junctionCount; ++junction)
+    {
+        auto const point = offset(center, positionDistribution(random), positionDistribution(random));
+        for (auto coordinateCount = coordinateCountDistribution(random); coordinateCount > 0; --coordinateCount)
+            coordinates.push_back(offset(point, offsetDistribution(random), offsetDistribution(random)));
+    }
+    return coordinates;
+}
+
+/// Coordinates 4cm apart along a diagonal line, then 200 around its middle, all of which form a single cluster of many cells.
+std::vector<Point> denseCluster(Point const & center, std::mt19937 & random)
+{
+    auto offsetDistribution = std::uniform_real_distribution<double>{-0.3, 0.3};
+    auto coordinates = std::vector<Point>{};
+    for (auto step = -100; step <= 100; ++step)
+        coordinates.push_back(offset(center, 0.04 * step, 0.03 * step));
+    for (size_t index = 0; index < 200; ++index)
+        coordinates.push_back(offset(center, offsetDistribution(random), offsetDistribution(random)));
+    return coordinates;
+}
+
+std::vector<Point> shuffled(std::vector<Point> coordinates, std::mt19937 & random)
+{
+    std::shuffle(coordinates.begin(), coordinates.end(), random);
+    return coordinates;
+}
+
+}  // namespace
+
+SCENARIO("Coordinates are merged as if one after another", "[UniquePoints]")
+{
+    auto random = std::mt19937{42};
+    auto const berlin = Point{Point::Longitude{13.4}, Point::Latitude{52.5}};
+    auto const north = Point{Point::Longitude{13.4}, Point::Latitude{89.9}};
+    auto const south = Point{Point::Longitude{-71.0}, Point::Latitude{-89.9}};
+
+    GIVEN("small junctions straddling cell rows and columns")
+    {
+        // More clusters than one thread merges at once.
+        auto const coordinates = shuffled(junctions(berlin, 1500, random), random);
+        auto const expected = mergeSequentially(coordinates);
+        REQUIRE(expected.count > 1500);
+        REQUIRE(expected.count < coordinates.size());
+
+        WHEN("they are merged by a single thread")
+        {
+            auto const uniquePoints = mergeCoordinates(coordinates, 1);
+            THEN("the result is that of merging them one after another")
+            {
+                REQUIRE(uniquePoints.count == expected.count);
+                REQUIRE(describe(uniquePoints) == describe(expected));
+            }
+        }
+        WHEN("they are merged by several threads")
+        {
+            auto const uniquePoints = mergeCoordinates(coordinates, 8);
+            THEN("the result is that of merging them one after another")
+            {
+                REQUIRE(uniquePoints.count == expected.count);
+                REQUIRE(describe(uniquePoints) == describe(expected));
+            }
+        }
+    }
+    GIVEN("clusters of more than 64 coordinates among small junctions")
+    {
+        auto coordinates = junctions(berlin, 200, random);
+        for (auto const & center : {berlin, offset(berlin, 100.0, -50.0)})
+        {
+            auto const cluster = denseCluster(center, random);
+            coordinates.insert(coordinates.end(), cluster.begin(), cluster.end());
+        }
+        coordinates = shuffled(coordinates, random);
+        auto const expected = mergeSequentially(coordinates);
+
+        WHEN("they are merged by a single thread")
+        {
+            auto const uniquePoints = mergeCoordinates(coordinates, 1);
+            THEN("the result is that of merging them one after another")
+            {
+                REQUIRE(uniquePoints.count == expected.count);
+                REQUIRE(describe(uniquePoints) == describe(expected));
+            }
+        }
+        WHEN("they are merged by several threads")
+        {
+            auto const uniquePoints = mergeCoordinates(coordinates, 8);
+            THEN("the result is that of merging them one after another")
+            {
+                REQUIRE(uniquePoints.count == expected.count);
+                REQUIRE(describe(uniquePoints) == describe(expected));
+            }
+        }
+    }
+    GIVEN("junctions and clusters next to the poles, where the merge distance spans hundreds of columns")
+    {
+        auto coordinates = std::vector<Point>{};
+        for (auto const & pole : {north, south})
+        {
+            auto const poleJunctions = junctions(pole, 300, random);
+            coordinates.insert(coordinates.end(), poleJunctions.begin(), poleJunctions.end());
+            auto const cluster = denseCluster(pole, random);
+            coordinates.insert(coordinates.end(), cluster.begin(), cluster.end());
+        }
+        coordinates = shuffled(coordinates, random);
+        auto const expected = mergeSequentially(coordinates);
+
+        WHEN("they are merged by a single thread")
+        {
+            auto const uniquePoints = mergeCoordinates(coordinates, 1);
+            THEN("the result is that of merging them one after another")
+            {
+                REQUIRE(uniquePoints.count == expected.count);
+                REQUIRE(describe(uniquePoints) == describe(expected));
+            }
+        }
+        WHEN("they are merged by several threads")
+        {
+            auto const uniquePoints = mergeCoordinates(coordinates, 8);
+            THEN("the result is that of merging them one after another")
+            {
+                REQUIRE(uniquePoints.count == expected.count);
+                REQUIRE(describe(uniquePoints) == describe(expected));
+            }
+        }
+    }
+}
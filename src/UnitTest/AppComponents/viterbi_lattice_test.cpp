@@ -0,0 +1,220 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "StreetGrid.h"
+
+#include <AppComponents/Common/Matcher/Routing/Helper.h>
+#include <AppComponents/Common/Matcher/Routing/ViterbiLattice.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace AppComponents::Common;
+using namespace AppComponents::Common::Matcher::Routing;
+
+namespace {
+
+constexpr auto configuration = ViterbiLattice::Configuration{5.0, 10.0, 20.0, 0};
+
+}  // namespace
+
+SCENARIO("Lattice states are weighted by their emission costs", "[ViterbiLattice]")
+{
+    GIVEN("a sampling point with a candidate off the street and off the track heading")
+    {
+        auto const grid = StreetGrid{2};
+        auto const track = GridTrack{grid, {StreetGrid::junction(0, 0), StreetGrid::junction(1, 0)}, 0.0003, 10.0};
+        auto samplingPointList = track.samplingPointList;
+        REQUIRE(!samplingPointList.empty());
+        auto & candidates = samplingPointList.front().candidates;
+        REQUIRE(candidates.size() >= 2);
+        candidates.front().streetSegmentDistance = 10.0;
+        candidates.front().streetSegmentHeadingDifference = 20.0;
+        candidates.front().streetSegmentTravelDirection = Types::Street::TravelDirection::forwards;
+
+        auto const streetLengthRouting = grid.makeRouting(samplingPointList);
+
+        THEN("each candidate becomes a state per travel direction, with the negative log-likelihood of its deviations")
+        {
+            auto const layer = ViterbiLattice{streetLengthRouting.router(), configuration, samplingPointList}.makeLayer(0);
+            REQUIRE(layer.size() == 2 * candidates.size() - 1);
+
+            CHECK(layer.front().selection.candidate.index == 0);
+            CHECK(layer.front().selection.candidate.consideredForwards);
+            CHECK(layer.front().emissionCost == Approx(0.5 * (2.0 * 2.0 + 2.0 * 2.0)));
+
+            for (auto const & state : layer)
+            {
+                auto const & candidate = candidates[state.selection.candidate.index];
+                auto const distance = candidate.streetSegmentDistance / configuration.measurementNoise;
+                auto const headingDifference = candidate.streetSegmentHeadingDifference / configuration.headingNoise;
+                CHECK(state.selection.index == 0);
+                CHECK(state.emissionCost == Approx(0.5 * (distance * distance + headingDifference * headingDifference)));
+                CHECK(state.cost == std::numeric_limits<double>::infinity());
+                CHECK(!state.previous);
+            }
+        }
+
+        THEN("only the best candidates become states if limited")
+        {
+            auto limited = configuration;
+            limited.maxCandidates = 1;
+            auto const layer = ViterbiLattice{streetLengthRouting.router(), limited, samplingPointList}.makeLayer(0);
+            REQUIRE(layer.size() == 1);
+            CHECK(layer.front().selection.candidate.index == 0);
+        }
+    }
+}
+
+SCENARIO("Lattice layers are connected by their transition costs", "[ViterbiLattice]")
+{
+    GIVEN("two consecutive sampling points on a grid")
+    {
+        auto const grid = StreetGrid{3};
+        auto const track = GridTrack{grid, {StreetGrid::junction(0, 1), StreetGrid::junction(2, 1)}, 0.0004, 10.0};
+        REQUIRE(track.samplingPointList.size() >= 2);
+        auto const streetLengthRouting = grid.makeRouting(track.samplingPointList);
+        auto const & router = streetLengthRouting.router();
+        auto const viterbiLattice = ViterbiLattice{router, configuration, track.samplingPointList};
+
+        auto sourceLayer = viterbiLattice.makeLayer(0);
+        ViterbiLattice::restart(sourceLayer);
+        auto const unconnectedTargetLayer = viterbiLattice.makeLayer(1);
+        auto targetLayer = unconnectedTargetLayer;
+        auto routingStatistic = Types::Routing::RoutingStatistic{};
+        REQUIRE(viterbiLattice.connect(sourceLayer, targetLayer, routingStatistic));
+
+        THEN("the first layer only costs its emission costs")
+        {
+            for (auto const & state : sourceLayer)
+                CHECK(state.cost == state.emissionCost);
+        }
+
+        THEN("each reached state keeps its best predecessor")
+        {
+            auto const samplingPointDistance = calcApproximateDistanceBetweenSamplingPoints(0, 1, track.samplingPointList);
+            size_t reachedCount = 0;
+            for (auto const & unconnectedState : unconnectedTargetLayer)
+            {
+                auto bestCost = std::numeric_limits<double>::infinity();
+                for (auto const & sourceState : sourceLayer)
+                {
+                    auto const route = router({sourceState.selection, unconnectedState.selection});
+                    if (!route->subRoutes.empty())
+                        bestCost = std::min(bestCost, sourceState.cost + std::abs(route->length() - samplingPointDistance) / configuration.transitionScale + unconnectedState.emissionCost);
+                }
+                if (bestCost == std::numeric_limits<double>::infinity())
+                    continue;
+                ++reachedCount;
+
+                auto const state = std::find_if(targetLayer.begin(), targetLayer.end(), [&](auto const & state) { return state.selection == unconnectedState.selection; });
+                REQUIRE(state != targetLayer.end());
+                CHECK(state->cost == Approx(bestCost));
+                REQUIRE(state->previous);
+                REQUIRE(state->route);
+                CHECK(state->route->source.samplingPoint == sourceLayer[*state->previous].selection);
+                CHECK(state->route->target.samplingPoint == state->selection);
+            }
+            CHECK(targetLayer.size() == reachedCount);
+        }
+
+        THEN("all state pairs are routed")
+        {
+            CHECK(routingStatistic.calculated.size() == sourceLayer.size() * unconnectedTargetLayer.size());
+        }
+    }
+}
+
+SCENARIO("The best path through the lattice is traced back", "[ViterbiLattice]")
+{
+    GIVEN("a track around a corner of a grid")
+    {
+        auto const grid = StreetGrid{3};
+        auto const track = GridTrack{grid, {StreetGrid::junction(0, 0), StreetGrid::junction(2, 0), StreetGrid::junction(2, 2)}, 0.0003, 10.0};
+        auto const streetLengthRouting = grid.makeRouting(track.samplingPointList);
+
+        auto routeList = Types::Routing::RouteList{};
+        auto routingStatistic = Types::Routing::RoutingStatistic{};
+        ViterbiLattice{streetLengthRouting.router(), configuration, track.samplingPointList}(routeList, routingStatistic);
+
+        THEN("consecutive sampling points are connected along the streets driven")
+        {
+            REQUIRE(routeList.size() == track.samplingPointList.size() - 1);
+            auto length = 0.0;
+            for (size_t index = 0; index < routeList.size(); ++index)
+            {
+                auto const & route = *routeList[index];
+                CHECK(route.source.samplingPoint.index == index);
+                CHECK(route.target.samplingPoint.index == index + 1);
+                if (index > 0)
+                    CHECK(route.source.samplingPoint == routeList[index - 1]->target.samplingPoint);
+                length += route.length();
+            }
+            // The track runs along the streets, so the matched length is the track length between the first and last sampling point.
+            auto trackLength = 0.0;
+            for (size_t index = 1; index < track.samplingPointList.size(); ++index)
+                trackLength += calcApproximateDistanceBetweenSamplingPoints(index - 1, index, track.samplingPointList);
+            CHECK(length == Approx(trackLength).epsilon(0.01));
+        }
+
+        THEN("the routes of the best path are visited")
+        {
+            REQUIRE(routingStatistic.visited.size() == routeList.size());
+            for (auto const & [selection, succeeded] : routingStatistic.visited)
+                CHECK(succeeded);
+        }
+    }
+}
+
+SCENARIO("The lattice is flushed where the track is interrupted", "[ViterbiLattice]")
+{
+    GIVEN("a track with a sampling point without candidates")
+    {
+        auto const grid = StreetGrid{3};
+        auto const track = GridTrack{grid, {StreetGrid::junction(0, 0), StreetGrid::junction(2, 0)}, 0.0003, 10.0};
+        auto samplingPointList = track.samplingPointList;
+        REQUIRE(samplingPointList.size() >= 5);
+        auto const gap = samplingPointList.size() / 2;
+        samplingPointList[gap].candidates.clear();
+        auto const streetLengthRouting = grid.makeRouting(samplingPointList);
+
+        auto routeList = Types::Routing::RouteList{};
+        auto routingStatistic = Types::Routing::RoutingStatistic{};
+        ViterbiLattice{streetLengthRouting.router(), configuration, samplingPointList}(routeList, routingStatistic);
+
+        THEN("the pieces before and after it are matched independently")
+        {
+            REQUIRE(routeList.size() == samplingPointList.size() - 3);
+            for (auto const & route : routeList)
+            {
+                CHECK(route->target.samplingPoint.index == route->source.samplingPoint.index + 1);
+                CHECK(route->source.samplingPoint.index != gap);
+                CHECK(route->target.samplingPoint.index != gap);
+            }
+        }
+    }
+
+    GIVEN("a single sampling point")
+    {
+        auto const grid = StreetGrid{2};
+        auto const track = GridTrack{grid, {StreetGrid::junction(0, 0), StreetGrid::junction(1, 0)}, 0.0003, 10.0};
+        auto const samplingPointList = Types::Routing::SamplingPointList{track.samplingPointList.front()};
+        auto const streetLengthRouting = grid.makeRouting(samplingPointList);
+
+        auto routeList = Types::Routing::RouteList{};
+        auto routingStatistic = Types::Routing::RoutingStatistic{};
+        ViterbiLattice{streetLengthRouting.router(), configuration, samplingPointList}(routeList, routingStatistic);
+
+        THEN("no route is flushed")
+        {
+            CHECK(routeList.empty());
+            CHECK(routingStatistic.visited.empty());
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <Generic/Map/DenseIdMap.h>
+#include <Generic/Map/FlatHashMap.h>
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using namespace Generic;
+
+SCENARIO("Flat hash maps behave like unordered maps", "[Generic][FlatHashMap]")
+{
+    GIVEN("An empty flat hash map")
+    {
+        auto map = FlatHashMap<size_t, std::string>{};
+
+        THEN("it has no entries")
+        {
+            REQUIRE(map.empty());
+            REQUIRE(map.begin() == map.end());
+            REQUIRE(map.find(0) == map.end());
+            REQUIRE_THROWS_AS(map.at(0), std::out_of_range);
+        }
+
+        WHEN("entries are inserted")
+        {
+            REQUIRE(map.insert({1, "one"}).second);
+            REQUIRE(map.insert({2, "two"}).second);
+            REQUIRE_FALSE(map.insert({1, "uno"}).second);
+            map[3] = "three";
+
+            THEN("they can be found and existing entries are not replaced")
+            {
+                REQUIRE(map.size() == 3);
+                REQUIRE(map.at(1) == "one");
+                REQUIRE(map.find(2)->second == "two");
+                REQUIRE(map.count(3) == 1);
+                REQUIRE(map.count(4) == 0);
+            }
+            THEN("iterating visits each entry once")
+            {
+                size_t sum = 0;
+                for (auto const & [key, value] : map)
+                    sum += key;
+                REQUIRE(sum == 6);
+            }
+        }
+    }
+
+    GIVEN("Random insertions and erasures with colliding keys")
+    {
+        auto map = FlatHashMap<size_t, size_t>{};
+        auto reference = std::unordered_map<size_t, size_t>{};
+        auto random = std::mt19937{42};
+        auto keyDistribution = std::uniform_int_distribution<size_t>{0, 2000};
+
+        for (size_t step = 0; step < 20000; ++step)
+        {
+            // Multiples of a large power of two collide for weak hashes.
+            auto const key = keyDistribution(random) << 20;
+            if (random() % 3 == 0)
+                REQUIRE(map.erase(key) == reference.erase(key));
+            else
+                REQUIRE(map.insert({key, step}).second == reference.insert({key, step}).second);
+        }
+
+        THEN("the map holds the same entries as an unordered map")
+        {
+            REQUIRE(map.size() == reference.size());
+            for (auto const & [key, value] : reference)
+                REQUIRE(map.at(key) == value);
+            size_t count = 0;
+            for (auto const & entry : map)
+            {
+                REQUIRE(reference.at(entry.first) == entry.second);
+                ++count;
+            }
+            REQUIRE(count == reference.size());
+        }
+
+        WHEN("the map is cleared")
+        {
+            map.clear();
+
+            THEN("it is empty")
+            {
+                REQUIRE(map.empty());
+                REQUIRE(map.begin() == map.end());
+            }
+        }
+    }
+}
+
+SCENARIO("Flat hash sets hold unique keys", "[Generic][FlatHashMap]")
+{
+    auto set = FlatHashSet<int>{};
+    REQUIRE(set.insert(-1).second);
+    REQUIRE(set.insert(7).second);
+    REQUIRE_FALSE(set.insert(7).second);
+    REQUIRE(set.size() == 2);
+    REQUIRE(set.find(7) != set.end());
+    REQUIRE(set.find(8) == set.end());
+    REQUIRE(set.erase(-1) == 1);
+    REQUIRE(set.count(-1) == 0);
+}
+
+SCENARIO("Dense id maps are indexed by id", "[Generic][DenseIdMap]")
+{
+    auto map = DenseIdMap<size_t, double>{};
+    REQUIRE(map.insert({5, 0.5}));
+    REQUIRE(map.insert({0, 1.0}));
+    REQUIRE_FALSE(map.insert({5, 2.0}));
+
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.at(5) == 0.5);
+    REQUIRE(map.at(0) == 1.0);
+    REQUIRE(map.count(3) == 0);
+    REQUIRE(map.find(6) == nullptr);
+    REQUIRE_THROWS_AS(map.at(3), std::out_of_range);
+}
@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <UnitTest/Helpers.h>
+
+#include <Core/Common/Geometry/Conversion.h>
+#include <Core/Common/Geometry/PackedLineStrings.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace Core::Common::Geometry;
+
+namespace {
+
+    /// Encodes a LINESTRING as WKB, each point has 2 to 4 coordinates, depending on \p type.
+    std::basic_string<std::byte>
+    toWkb(bool const littleEndian, std::uint32_t const type, std::optional<std::uint32_t> const srid, std::vector<std::vector<double>> const & points)
+    {
+        auto wkb = std::basic_string<std::byte>{};
+        auto append = [&](auto const value)
+        {
+            std::byte bytes[sizeof(value)];
+            std::memcpy(bytes, &value, sizeof(value));
+            // The tests run on little endian machines.
+            if (littleEndian)
+                wkb.append(bytes, sizeof(value));
+            else
+                for (size_t i = sizeof(value); i > 0; --i)
+                    wkb.push_back(bytes[i - 1]);
+        };
+        append(std::uint8_t{littleEndian});
+        append(type);
+        if (srid)
+            append(*srid);
+        append(static_cast<std::uint32_t>(points.size()));
+        for (auto const & point : points)
+            for (auto const coordinate : point)
+                append(coordinate);
+        return wkb;
+    }
+
+}  // namespace
+
+SCENARIO("Line strings are decoded from well-known binary", "[geometry]")
+{
+    auto const expected = LineString{Point{13.3777_lon, 52.5163_lat}, Point{13.3801234_lon, 52.5170987_lat}, Point{-0.1275_lon, -51.5072_lat}};
+    auto const coordinates = std::vector<std::vector<double>>{{13.3777, 52.5163}, {13.3801234, 52.5170987}, {-0.1275, -51.5072}};
+
+    GIVEN("A two-dimensional LINESTRING in either byte order")
+    {
+        THEN("the coordinates are decoded exactly")
+        {
+            require_close(wkbToLineString(toWkb(true, 2, std::nullopt, coordinates)), expected, 0.0);
+            require_close(wkbToLineString(toWkb(false, 2, std::nullopt, coordinates)), expected, 0.0);
+            REQUIRE(wkbToLineString(toWkb(true, 2, std::nullopt, {})).empty());
+        }
+    }
+    GIVEN("A LINESTRING with additional dimensions")
+    {
+        auto withZm = coordinates;
+        for (auto & point : withZm)
+            point.insert(point.end(), {100.0, 7.0});
+
+        THEN("the Z and M coordinates are skipped")
+        {
+            require_close(wkbToLineString(toWkb(true, 3002, std::nullopt, withZm)), expected, 0.0);
+            require_close(wkbToLineString(toWkb(false, 0xc0000002u, std::nullopt, withZm)), expected, 0.0);
+        }
+    }
+    GIVEN("An extended LINESTRING with SRID")
+    {
+        THEN("the SRID is skipped")
+        {
+            require_close(wkbToLineString(toWkb(true, 0x20000002u, 4326, coordinates)), expected, 0.0);
+        }
+    }
+    GIVEN("Invalid data")
+    {
+        auto truncated = toWkb(true, 2, std::nullopt, coordinates);
+        truncated.pop_back();
+
+        THEN("decoding fails")
+        {
+            REQUIRE_THROWS_AS(wkbToLineString(truncated), std::domain_error);
+            REQUIRE_THROWS_AS(wkbToLineString(toWkb(true, 1, std::nullopt, {{13.3777, 52.5163}})), std::domain_error);
+            REQUIRE_THROWS_AS(wkbToLineString({}), std::domain_error);
+        }
+    }
+}
+
+SCENARIO("Geometries are converted to and from WKT", "[geometry]")
+{
+    GIVEN("A line string")
+    {
+        auto const lineString = LineString{Point{13.3777_lon, 52.5163_lat}, Point{13.380123456789_lon, -52.5170987_lat}};
+        auto const points = std::vector<Point>{lineString.begin(), lineString.end()};
+
+        THEN("it is written with 14 significant digits")
+        {
+            REQUIRE(toWkt(points) == "LINESTRING(13.3777 52.5163,13.380123456789 -52.5170987)");
+            REQUIRE(toWkt(points.front()) == "POINT(13.3777 52.5163)");
+            REQUIRE(toWkt(std::vector<std::vector<Point>>{points, {}}) == "MULTILINESTRING((13.3777 52.5163,13.380123456789 -52.5170987),())");
+            REQUIRE(toWkt(std::vector<Point>{Point{1e-7_lon, -1234567.890123456_lat}}) == "LINESTRING(1e-07 -1234567.8901235)");
+        }
+        THEN("it is appended to a buffer")
+        {
+            auto buffer = std::string{"id;"};
+            appendWkt(buffer, points);
+            buffer += ';';
+            appendWkt(buffer, points.back());
+            REQUIRE(buffer == "id;" + toWkt(points) + ';' + toWkt(points.back()));
+        }
+        THEN("it is read back")
+        {
+            require_close(toLineString(toWkt(points)), lineString, 0.0);
+            require_close(toPoint(toWkt(points.back())), points.back(), 0.0);
+            auto const multiLineString = toMultiLineString(toWkt(std::vector<std::vector<Point>>{points, {}, points}));
+            REQUIRE(multiLineString.size() == 3);
+            require_close(multiLineString[0], lineString, 0.0);
+            REQUIRE(multiLineString[1].empty());
+            require_close(multiLineString[2], lineString, 0.0);
+        }
+    }
+    GIVEN("WKT of other writers")
+    {
+        THEN("whitespace, case, empty geometries and additional dimensions are accepted")
+        {
+            auto const expected = LineString{Point{1.0_lon, 2.0_lat}, Point{3.5_lon, -4.0_lat}};
+            require_close(toLineString(std::string_view{" linestring ( 1 2 , 3.5 -4 ) "}), expected, 0.0);
+            require_close(toLineString(std::string_view{"LINESTRING Z (1 2 10, 3.5 -4 20)"}), expected, 0.0);
+            require_close(toPoint("POINT ZM (1 2 3 4)"), expected.front(), 0.0);
+            REQUIRE(toLineString(std::string_view{"LINESTRING EMPTY"}).empty());
+            REQUIRE(toMultiLineString("MULTILINESTRING EMPTY").empty());
+            REQUIRE(toMultiLineString("MULTILINESTRING((1 2,3.5 -4),(1 2))").size() == 2);
+        }
+        THEN("malformed WKT is rejected")
+        {
+            REQUIRE_THROWS_AS(toLineString(std::string_view{"LINESTRING(1 2,)"}), std::domain_error);
+            REQUIRE_THROWS_AS(toLineString(std::string_view{"LINESTRING(1 2"}), std::domain_error);
+            REQUIRE_THROWS_AS(toLineString(std::string_view{"LINESTRING(1 2) 3"}), std::domain_error);
+            REQUIRE_THROWS_AS(toLineString(std::string_view{"POINT(1 2)"}), std::domain_error);
+            REQUIRE_THROWS_AS(toPoint("POINT(1)"), std::domain_error);
+            REQUIRE_THROWS_AS(toPoint("POINT(1 2,3 4)"), std::domain_error);
+            REQUIRE_THROWS_AS(toMultiLineString("MULTILINESTRING(1 2)"), std::domain_error);
+        }
+    }
+}
+
+SCENARIO("Line strings are stored as packed fixed-point coordinates", "[geometry]")
+{
+    GIVEN("Two line strings with at most 7 decimal places")
+    {
+        auto const first = LineString{Point{13.3777_lon, 52.5163_lat}, Point{13.3801234_lon, 52.5170987_lat}, Point{-0.1275_lon, -51.5072_lat}};
+        auto const second = LineString{Point{179.9999999_lon, 89.9999999_lat}, Point{-180.0_lon, -90.0_lat}};
+
+        WHEN("they are added to a packed line string list")
+        {
+            PackedLineStringList list;
+            list.reserve(3, first.size() + second.size());
+            auto const firstIndex = list.push_back(first);
+            auto const emptyIndex = list.push_back(LineString{});
+            auto const secondIndex = list.push_back(second);
+
+            THEN("the indices and sizes are consistent")
+            {
+                REQUIRE(firstIndex == 0);
+                REQUIRE(emptyIndex == 1);
+                REQUIRE(secondIndex == 2);
+                REQUIRE(list.size() == 3);
+                REQUIRE(list.numPoints() == first.size() + second.size());
+                REQUIRE(list[firstIndex].size() == first.size());
+                REQUIRE(list[emptyIndex].empty());
+                REQUIRE(list[secondIndex].size() == second.size());
+                REQUIRE_THROWS_AS(list.at(3), std::out_of_range);
+            }
+            THEN("the views return the points unchanged")
+            {
+                require_close(list[firstIndex].toLineString(), first, 0.0);
+                require_close(list[secondIndex].toLineString(), second, 0.0);
+                require_close(list[firstIndex].front(), first.front(), 0.0);
+                require_close(list[secondIndex].back(), second.back(), 0.0);
+                size_t i = 0;
+                for (auto const point : list[firstIndex])
+                    require_close(point, first[i++], 0.0);
+                REQUIRE(i == first.size());
+            }
+            THEN("the views are written like the line strings")
+            {
+                REQUIRE(toWkt(list[firstIndex]) == toWkt(std::vector<Point>{first.begin(), first.end()}));
+                REQUIRE(toWkt(list[emptyIndex]) == "LINESTRING()");
+                assert_jsoneql(toGeoJson(list[secondIndex]).dump(), toGeoJson(second).dump());
+            }
+        }
+    }
+    GIVEN("A line string with more decimal places")
+    {
+        auto const lineString = LineString{Point{13.380123456789_lon, -52.517098765432_lat}};
+
+        THEN("its points are rounded to E7")
+        {
+            PackedLineStringList list;
+            list.push_back(lineString);
+            require_close(list[0].front(), Point{13.3801235_lon, -52.5170988_lat}, 0.0);
+        }
+    }
+}
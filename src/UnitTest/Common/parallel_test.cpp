@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <Generic/Parallel/Parallel.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace Generic;
+
+SCENARIO("Work is split into batches processed by several threads", "[Generic][Parallel]")
+{
+    GIVEN("Indices written by several threads")
+    {
+        auto visits = std::vector<int>(10007, 0);
+        Parallel::forEachBatch(
+            visits.size(),
+            100,
+            4,
+            [&](size_t const begin, size_t const end)
+            {
+                for (auto index = begin; index < end; ++index)
+                    ++visits[index];
+            });
+
+        THEN("each index is processed once")
+        {
+            REQUIRE(std::all_of(visits.begin(), visits.end(), [](int const count) { return count == 1; }));
+        }
+    }
+
+    GIVEN("A failing batch")
+    {
+        auto processed = std::atomic<size_t>{0};
+        auto process = [&](size_t const begin, size_t const end)
+        {
+            if (begin == 500)
+                throw std::runtime_error("batch failed");
+            processed += end - begin;
+        };
+
+        THEN("the error is rethrown after all threads finished")
+        {
+            REQUIRE_THROWS_AS(Parallel::forEachBatch(100000, 100, 4, process), std::runtime_error);
+            REQUIRE(processed < 100000);
+        }
+    }
+
+    GIVEN("Nothing to do")
+    {
+        THEN("no batch is processed")
+        {
+            Parallel::forEachBatch(0, 100, 4, [](size_t, size_t) { FAIL(); });
+        }
+    }
+
+    GIVEN("Random numbers")
+    {
+        auto random = std::mt19937{42};
+        auto numbers = std::vector<unsigned>(50000);
+        std::generate(numbers.begin(), numbers.end(), random);
+        auto expected = numbers;
+        std::sort(expected.begin(), expected.end(), std::greater<>{});
+
+        THEN("they are sorted with any number of threads")
+        {
+            for (size_t const threadCount : {1, 3, 8})
+            {
+                auto sorted = numbers;
+                Parallel::sort(sorted.begin(), sorted.end(), std::greater<>{}, threadCount);
+                REQUIRE(sorted == expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <Generic/Pool/Pool.h>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+
+using namespace Generic;
+
+namespace {
+
+    /// Stands in for a database connection.
+    struct StubConnection
+    {
+        size_t id;
+        bool broken{false};
+    };
+
+}  // namespace
+
+SCENARIO("Pooled objects are created on demand and reused", "[Generic][Pool]")
+{
+    auto created = std::atomic<size_t>{0};
+    auto failNextCreation = std::atomic<bool>{false};
+    auto pool = Pool<StubConnection>{
+        2,
+        [&]
+        {
+            if (failNextCreation.exchange(false))
+                throw std::runtime_error("connection refused");
+            return std::make_unique<StubConnection>(StubConnection{created++});
+        },
+        [](StubConnection & connection, Pool<StubConnection>::Clock::duration) { return !connection.broken; }};
+
+    GIVEN("A released object")
+    {
+        pool.acquire();
+
+        THEN("it is handed out again")
+        {
+            REQUIRE(pool.acquire()->id == 0);
+            REQUIRE(created == 1);
+        }
+    }
+
+    GIVEN("Objects in use")
+    {
+        auto first = pool.acquire();
+        auto second = pool.acquire();
+        REQUIRE(first->id != second->id);
+
+        THEN("acquiring blocks until one is released")
+        {
+            auto third = std::async(std::launch::async, [&] { return pool.acquire(); });
+            REQUIRE(third.wait_for(std::chrono::milliseconds{50}) == std::future_status::timeout);
+            auto const secondId = second->id;
+            second.reset();
+            REQUIRE(third.get()->id == secondId);
+            REQUIRE(created == 2);
+        }
+        THEN("broken objects are replaced")
+        {
+            first->broken = true;
+            first.reset();
+            REQUIRE(pool.acquire()->id == 2);
+        }
+        THEN("objects outlive the pool")
+        {
+            pool = Pool<StubConnection>{1, [] { return std::make_unique<StubConnection>(); }, [](StubConnection &, Pool<StubConnection>::Clock::duration) { return true; }};
+            REQUIRE(first->id == 0);
+        }
+    }
+
+    GIVEN("A failing creation")
+    {
+        failNextCreation = true;
+        REQUIRE_THROWS_AS(pool.acquire(), std::runtime_error);
+
+        THEN("the pool stays usable")
+        {
+            auto first = pool.acquire();
+            auto second = pool.acquire();
+            REQUIRE(created == 2);
+        }
+    }
+}
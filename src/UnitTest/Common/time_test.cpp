@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: © 2018 Ambrosys GmbH
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <Core/Common/Time/Helper.h>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+using namespace Core::Common::Time;
+
+namespace {
+
+std::chrono::system_clock::time_point fromSeconds(std::int64_t const seconds)
+{
+    return std::chrono::system_clock::time_point{std::chrono::seconds{seconds}};
+}
+
+}  // namespace
+
+SCENARIO("ISO-8601 timestamps are parsed and formatted in UTC", "[time]")
+{
+    GIVEN("A timestamp")
+    {
+        auto const time = fromSeconds(1529637250);  // 2018-06-22T03:14:10Z
+
+        THEN("it is formatted with and without zone designator")
+        {
+            REQUIRE(toIsoString(time) == "2018-06-22T03:14:10");
+            REQUIRE(toIsoZString(time) == "2018-06-22T03:14:10Z");
+            REQUIRE(toString(time, "%H:%M:%S") == "03:14:10");
+        }
+        THEN("it is parsed with and without fractional seconds and zone designator")
+        {
+            REQUIRE(fromIsoString("2018-06-22T03:14:10") == std::make_pair(time, true));
+            REQUIRE(fromIsoString("2018-06-22T03:14:10.250") == std::make_pair(time, true));
+            REQUIRE(fromIsoString("2018-06-22T03:14:10Z") == std::make_pair(time, true));
+            REQUIRE(fromIsoZString("2018-06-22T03:14:10Z") == std::make_pair(time, true));
+            REQUIRE(fromIsoZString("2018-06-22T03:14:10.000Z") == std::make_pair(time, true));
+            REQUIRE(fromString("2018-06-22T03:14:10", "%Y-%m-%dT%H:%M:%S") == std::make_pair(time, true));
+        }
+    }
+
+    GIVEN("Invalid timestamps")
+    {
+        THEN("parsing fails")
+        {
+            REQUIRE_FALSE(fromIsoString("").second);
+            REQUIRE_FALSE(fromIsoString("2018-06-22").second);
+            REQUIRE_FALSE(fromIsoString("2018-13-22T03:14:10").second);
+            REQUIRE_FALSE(fromIsoString("2018-06-22 03:14:10").second);
+            REQUIRE_FALSE(fromIsoString("2018-06-22T24:00:00").second);
+            REQUIRE_FALSE(fromIsoZString("2018-06-22T03:14:10").second);
+        }
+    }
+
+    GIVEN("Dates around leap days and the epoch")
+    {
+        THEN("they are converted like the civil calendar")
+        {
+            REQUIRE(fromIsoString("1970-01-01T00:00:00").first == fromSeconds(0));
+            REQUIRE(fromIsoString("1969-12-31T23:59:59").first == fromSeconds(-1));
+            REQUIRE(fromIsoString("2000-02-29T00:00:00").first == fromSeconds(951782400));
+            REQUIRE(fromIsoString("2000-03-01T00:00:00").first == fromSeconds(951868800));
+            REQUIRE(fromIsoString("2100-03-01T00:00:00").first == fromSeconds(4107542400));
+            REQUIRE(toIsoZString(fromSeconds(-1)) == "1969-12-31T23:59:59Z");
+            REQUIRE(toIsoZString(fromSeconds(4107542399)) == "2100-02-28T23:59:59Z");
+        }
+        THEN("days beyond the end of the month are carried over")
+        {
+            REQUIRE(fromIsoString("2019-02-30T00:00:00").first == fromIsoString("2019-03-02T00:00:00").first);
+        }
+    }
+
+    GIVEN("Random timestamps")
+    {
+        auto random = std::mt19937_64{42};
+        auto distribution = std::uniform_int_distribution<std::int64_t>{-2208988800, 4102444799};  // 1900 to 2099
+
+        THEN("formatting and parsing round trips, and formatting agrees with the C library")
+        {
+            for (int i = 0; i < 10000; ++i)
+            {
+                auto const time = fromSeconds(distribution(random));
+                REQUIRE(fromIsoString(toIsoString(time)) == std::make_pair(time, true));
+                REQUIRE(fromIsoZString(toIsoZString(time)) == std::make_pair(time, true));
+                REQUIRE(toIsoZString(time) == toString(time, "%Y-%m-%dT%H:%M:%SZ"));
+            }
+        }
+    }
+}
@@ -352,6 +352,78 @@ void route_with_filterfunction(FactoryFunction factory)
     }
 }
 
+void route_to_many_destinations(FactoryFunction factory)
+{
+    WHEN("routing on a triangle shaped dag with appendix sink and a disconnected node")
+    {
+        auto graph = LemonDigraph();
+        auto algorithm = factory(graph);
+        auto nodes = std::vector<Node>{};
+        for (unsigned int i = 0; i < 5; ++i)
+            nodes.push_back(graph.createNode());
+        auto edges = std::vector<Edge>{};
+        edges.push_back(graph.addEdge(nodes[0], nodes[1]));
+        edges.push_back(graph.addEdge(nodes[0], nodes[2]));
+        edges.push_back(graph.addEdge(nodes[1], nodes[2]));
+        edges.push_back(graph.addEdge(nodes[2], nodes[3]));
+        auto weight = std::unordered_map<Edge, double>{
+            {edges[0], 1.0f},
+            {edges[1], 3.0f},
+            {edges[2], 1.0f},
+            {edges[3], 2.0f},
+        };
+        auto costFunction = [&weight](Edge edge) { return weight[edge]; };
+        algorithm->setCost(costFunction);
+
+        auto destinations = std::vector<Node>{nodes[3], nodes[1], nodes[4], nodes[2], nodes[3]};
+        auto visits = std::vector<size_t>(destinations.size(), 0);
+        auto paths = std::vector<std::vector<Edge>>(destinations.size());
+        algorithm->runMany(
+            nodes[0],
+            destinations,
+            [&](size_t index, PathView path)
+            {
+                ++visits.at(index);
+                for (auto edge : path)
+                    paths[index].insert(paths[index].begin(), edge.edge());
+            });
+
+        THEN("every destination is visited exactly once")
+        {
+            for (auto count : visits)
+                REQUIRE(count == 1);
+        }
+        THEN("the paths are the shortest paths of one-to-one routing")
+        {
+            REQUIRE(paths[0] == std::vector<Edge>{edges[0], edges[2], edges[3]});
+            REQUIRE(paths[1] == std::vector<Edge>{edges[0]});
+            REQUIRE(paths[3] == std::vector<Edge>{edges[0], edges[2]});
+            REQUIRE(paths[4] == paths[0]);
+        }
+        THEN("the path to the disconnected node is empty")
+        {
+            REQUIRE(paths[2].empty());
+        }
+        THEN("the contiguous paths are the same paths in forward order")
+        {
+            auto contiguousPaths = std::vector<Path>(destinations.size());
+            algorithm->findPaths(nodes[0], destinations, [&](size_t index, Path && path) { contiguousPaths.at(index) = std::move(path); });
+            for (size_t index = 0; index < destinations.size(); ++index)
+            {
+                REQUIRE(contiguousPaths[index].size() == paths[index].size());
+                for (size_t edgeIndex = 0; edgeIndex < paths[index].size(); ++edgeIndex)
+                    REQUIRE(contiguousPaths[index][edgeIndex].edge == paths[index][edgeIndex]);
+            }
+            REQUIRE(contiguousPaths[0].back().cost == Approx(4.0));
+
+            auto const path = algorithm->findPath(nodes[0], nodes[3]);
+            REQUIRE(path.size() == 3);
+            REQUIRE(path.front().cost == Approx(1.0));
+            REQUIRE(path.back().cost == Approx(4.0));
+        }
+    }
+}
+
 SCENARIO("Test routing algorithm implementations", "[Graph][Routing]")
 {
     for (auto & impl : routing_implementations)
@@ -363,6 +435,7 @@ SCENARIO("Test routing algorithm implementations", "[Graph][Routing]")
             // route_on_cyclic_digraph( impl.factory );
             // route_with_costfunction( impl.factory );
             route_with_filterfunction(impl.factory);
+            route_to_many_destinations(impl.factory);
         }
     }
 }